@@ -0,0 +1,219 @@
+#!/usr/bin/env python3
+"""Flash and RAM footprint report for the qmk.json build targets.
+
+Usage: footprint.py [--feature NAME]... [--baseline REPORT] [--output REPORT]
+
+Every target is built once as configured, then once per `*_ENABLE` feature of
+its keymap rules.mk (and users/<keymap>/rules.mk) with that feature toggled,
+passed to `qmk compile -e` so no file is edited.  For each build the report
+records the .text/.data/.bss totals, flash (text + data) and RAM (data + bss),
+and the size and section of every symbol defined by userspace code, attributed
+to its source file from the ELF debug info.
+
+The report is JSON.  When a previous report exists at --baseline (by default
+the --output path, footprint.json), every build also gets its deltas against
+it, so the report can be committed and diffed like any other benchmark.
+Builds that fail are recorded with their error instead of aborting the run.
+"""
+import argparse
+import datetime
+import json
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+
+USERSPACE = os.path.dirname(os.path.realpath(__file__))
+
+FEATURE_RE = re.compile(r'^\s*([A-Z0-9_]+_ENABLE)\s*[:+?]?=\s*(yes|no)\s*(?:#.*)?$')
+
+# ELF e_machine to binutils prefix.
+TOOLCHAINS = {83: 'avr-', 40: 'arm-none-eabi-', 243: 'riscv32-unknown-elf-'}
+
+# nm symbol types to the Berkeley section they are counted in.
+SYMBOL_SECTIONS = {'t': 'text', 'w': 'text', 'v': 'data', 'd': 'data', 'g': 'data', 'b': 'bss', 's': 'bss'}
+
+
+def run(command, cwd=None):
+    return subprocess.run(command, cwd=cwd, check=True, capture_output=True, text=True).stdout
+
+
+def qmk_home():
+    home = run(['qmk', 'config', '-ro', 'user.qmk_home']).strip().split('=', 1)[-1]
+    if not home or home == 'None':
+        sys.exit('Cannot determine qmk_firmware location. `qmk config -ro user.qmk_home` is not set')
+    return home
+
+
+def build_targets():
+    with open(os.path.join(USERSPACE, 'qmk.json'), encoding='utf-8') as config:
+        return [tuple(target) for target in json.load(config)['build_targets']]
+
+
+def features(keyboard, keymap):
+    """Features set in the keymap and user rules.mk, last assignment wins."""
+    found = {}
+    for path in (
+        os.path.join(USERSPACE, 'keyboards', keyboard, 'keymaps', keymap, 'rules.mk'),
+        os.path.join(USERSPACE, 'users', keymap, 'rules.mk'),
+    ):
+        if not os.path.exists(path):
+            continue
+        with open(path, encoding='utf-8') as rules:
+            for line in rules:
+                match = FEATURE_RE.match(line)
+                if match:
+                    found[match.group(1)] = match.group(2)
+    return found
+
+
+def compile_elf(home, keyboard, keymap, overrides, workdir):
+    """Clean build of one variant, returns a private copy of its ELF."""
+    command = ['qmk', 'compile', '-c', '-kb', keyboard, '-km', keymap]
+    for name, value in overrides.items():
+        command += ['-e', f'{name}={value}']
+    result = subprocess.run(command, cwd=USERSPACE, capture_output=True, text=True)
+    if result.returncode != 0:
+        tail = (result.stdout + result.stderr).strip().splitlines()[-20:]
+        raise RuntimeError('\n'.join(tail))
+
+    target = f'{keyboard.replace("/", "_")}_{keymap}'
+    elf = os.path.join(home, '.build', f'{target}.elf')
+    if not os.path.exists(elf):
+        raise RuntimeError(f'build succeeded but {elf} is missing')
+    copy = os.path.join(workdir, f'{target}-{len(os.listdir(workdir))}.elf')
+    shutil.copyfile(elf, copy)
+    return copy
+
+
+def toolchain(elf):
+    with open(elf, 'rb') as image:
+        header = image.read(20)
+    machine = int.from_bytes(header[18:20], 'little')
+    if machine not in TOOLCHAINS:
+        sys.exit(f'{elf}: unsupported ELF machine {machine}')
+    return TOOLCHAINS[machine]
+
+
+def sections(elf, prefix):
+    """Berkeley totals: text, data and bss as the linker laid them out."""
+    lines = run([prefix + 'size', '-B', elf]).strip().splitlines()
+    text, data, bss = (int(field) for field in lines[1].split()[:3])
+    return {'text': text, 'data': data, 'bss': bss, 'flash': text + data, 'ram': data + bss}
+
+
+def user_symbols(elf, prefix):
+    """Symbols defined by userspace sources, by file relative to the userspace."""
+    symbols = {}
+    output = run([prefix + 'nm', '--print-size', '--line-numbers', '--defined-only', elf])
+    for line in output.splitlines():
+        fields, _, location = line.partition('\t')
+        parts = fields.split()
+        if len(parts) != 4 or not location:
+            continue
+        _, size, kind, name = parts
+        path = os.path.realpath(location.rsplit(':', 1)[0])
+        if os.path.commonpath([path, USERSPACE]) != USERSPACE:
+            continue
+        section = SYMBOL_SECTIONS.get(kind.lower())
+        if section is None:
+            # Read-only data lives in flash on every target.
+            section = 'text' if kind.lower() == 'r' else kind
+        source = os.path.relpath(path, USERSPACE)
+        symbols.setdefault(source, {})[name] = {'section': section, 'size': int(size, 16)}
+    return symbols
+
+
+def measure(home, keyboard, keymap, overrides, workdir):
+    try:
+        elf = compile_elf(home, keyboard, keymap, overrides, workdir)
+    except RuntimeError as error:
+        return {'overrides': overrides, 'error': str(error)}
+    prefix = toolchain(elf)
+    return {'overrides': overrides, 'sections': sections(elf, prefix), 'symbols': user_symbols(elf, prefix)}
+
+
+def symbol_deltas(before, after):
+    deltas = []
+    for source in sorted(set(before) | set(after)):
+        old, new = before.get(source, {}), after.get(source, {})
+        for name in sorted(set(old) | set(new)):
+            old_size = old.get(name, {}).get('size', 0)
+            new_size = new.get(name, {}).get('size', 0)
+            if old_size != new_size:
+                deltas.append({'source': source, 'symbol': name, 'before': old_size, 'after': new_size, 'delta': new_size - old_size})
+    return deltas
+
+
+def add_deltas(build, previous, default):
+    """Deltas against the same build of the previous report, and the feature cost."""
+    if 'sections' not in build:
+        return
+    if build is not default and 'sections' in default:
+        # What the toggled feature costs: enabled minus disabled, either way round.
+        enabled, disabled = (default, build) if 'no' in build['overrides'].values() else (build, default)
+        build['cost'] = {key: enabled['sections'][key] - disabled['sections'][key] for key in build['sections']}
+    if previous is not None and 'sections' in previous:
+        build['delta'] = {key: value - previous['sections'].get(key, 0) for key, value in build['sections'].items()}
+        build['symbol_deltas'] = symbol_deltas(previous['symbols'], build['symbols'])
+
+
+def print_summary(report):
+    for target, builds in report['targets'].items():
+        print(target)
+        for name, build in builds.items():
+            if 'error' in build:
+                print(f'  {name:<28} build failed')
+                continue
+            line = f'  {name:<28} flash {build["sections"]["flash"]:>6}  ram {build["sections"]["ram"]:>5}'
+            if 'cost' in build:
+                line += f'  feature costs {build["cost"]["flash"]:+d} flash, {build["cost"]["ram"]:+d} ram'
+            if 'delta' in build:
+                line += f'  vs previous {build["delta"]["flash"]:+d} flash, {build["delta"]["ram"]:+d} ram'
+            print(line)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument('--feature', action='append', help='only toggle this feature, may be repeated')
+    parser.add_argument('--baseline', help='previous report to diff against, defaults to --output')
+    parser.add_argument('--output', default=os.path.join(USERSPACE, 'footprint.json'), help='report path')
+    args = parser.parse_args()
+
+    baseline_path = args.baseline or args.output
+    previous = None
+    if os.path.exists(baseline_path):
+        with open(baseline_path, encoding='utf-8') as report:
+            previous = json.load(report)
+
+    home = qmk_home()
+    report = {
+        'generated': datetime.datetime.now(datetime.timezone.utc).isoformat(timespec='seconds'),
+        'commit': run(['git', 'rev-parse', '--short', 'HEAD'], cwd=USERSPACE).strip(),
+        'targets': {},
+    }
+    with tempfile.TemporaryDirectory() as workdir:
+        for keyboard, keymap in build_targets():
+            target = f'{keyboard}:{keymap}'
+            builds = {'default': measure(home, keyboard, keymap, {}, workdir)}
+            for name, value in sorted(features(keyboard, keymap).items()):
+                if args.feature and name not in args.feature:
+                    continue
+                toggled = 'no' if value == 'yes' else 'yes'
+                builds[f'{name}={toggled}'] = measure(home, keyboard, keymap, {name: toggled}, workdir)
+
+            old_builds = (previous or {}).get('targets', {}).get(target, {})
+            for name, build in builds.items():
+                add_deltas(build, old_builds.get(name), builds['default'])
+            report['targets'][target] = builds
+
+    with open(args.output, 'w', encoding='utf-8') as output:
+        json.dump(report, output, indent=2, sort_keys=True)
+        output.write('\n')
+    print_summary(report)
+
+
+if __name__ == '__main__':
+    main()
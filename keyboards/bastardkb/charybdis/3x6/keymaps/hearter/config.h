@@ -28,6 +28,11 @@
 
 /* Key Override feature is enabled in rules.mk */
 
+#ifdef RGB_MATRIX_ENABLE
+// Layer indicators are drawn by each half from its own `layer_state`.
+#    define SPLIT_LAYER_STATE_ENABLE
+#endif // RGB_MATRIX_ENABLE
+
 /* Charybdis-specific features. */
 
 #ifdef POINTING_DEVICE_ENABLE
@@ -16,6 +16,10 @@
  */
 #include QMK_KEYBOARD_H
 
+#include "leader_seq.h"
+#include "send_string_packed.h"
+#include "user_tasks.h"
+
 
 enum charybdis_keymap_layers {
     LAYER_BASE = 0,
@@ -51,7 +55,6 @@ static uint16_t auto_pointer_layer_timer = 0;
 #define ONE_PASS G(KC_BSLS)
 #define TABS LCAG(KC_T)
 #define RAYC G(KC_SPC)
-#define LEADER HYPR(KC_SPACE)
 #define LCRLY S(KC_LBRC)
 #define RCRLY S(KC_RBRC)
 #define CLN S(KC_SCLN)
@@ -75,9 +78,14 @@ static uint16_t auto_pointer_layer_timer = 0;
 
 enum custom_keycodes {
     TMUX = SAFE_RANGE,
+    LEADER, // Leader sequence, see users/hearter/leader_seq.txt
 };
 
 bool process_record_user(uint16_t keycode, keyrecord_t* record) {
+    if (!process_record_leader_seq(keycode, record)) {
+        return false;
+    }
+
     uint8_t mod_state = get_mods();
 
     switch(keycode) {
@@ -120,86 +128,158 @@ bool process_record_user(uint16_t keycode, keyrecord_t* record) {
         case TMUX:
             if (record->event.pressed) {
                 // on press
-                SEND_STRING(SS_LALT("t") SS_DELAY(200) "`t");
+                SEND_STRING_PACKED(SS_LALT("t") SS_DELAY(200) "`t");
             }
             break;
+
+        case LEADER:
+            if (record->event.pressed) {
+                // Without a known sequence this still sends HYPR+Space
+                leader_seq_start();
+            }
+            return false;
     }
     return true;
 }
 
+void housekeeping_task_user(void) {
+    user_tasks_run();
+}
+
 // clang-format off
+/** \brief QWERTY layout with home row mods (3 rows, 12 columns, 5 thumbs). */
+//   ╭──────────────────────────────────────────────────────╮ ╭──────────────────────────────────────────────────────╮
+//     TMUX,    KC_Q,    KC_W,    KC_E,    KC_R,    KC_T,       KC_Y,    KC_U,    KC_I,    KC_O,    KC_P,  TABS,
+//   ├──────────────────────────────────────────────────────┤ ├──────────────────────────────────────────────────────┤
+//     KC_CAPS,  HOME_A,  HOME_S,  HOME_D,  HOME_F,    KC_G,       KC_H,  HOME_J,  HOME_K,  HOME_L,HOME_QUO, RAYC,
+//   ├──────────────────────────────────────────────────────┤ ├──────────────────────────────────────────────────────┤
+//     ONE_PASS,   PT_Z,    KC_X,    KC_C,    KC_V,    KC_B,       KC_N,    KC_M, KC_COMM,  KC_DOT, PT_SLSH, LEADER,
+//   ╰──────────────────────────────────────────────────────┤ ├──────────────────────────────────────────────────────╯
+//                                MED_ESC, NAV_SPC, KC_TAB,    SYM_ENT, NUM_BSPC
+//                              ╰───────────────────────────╯ ╰──────────────────╯
+#define LAYOUT_LAYER_BASE                                                                                          \
+       TMUX,    KC_Q,    KC_W,    KC_E,    KC_R,    KC_T,       KC_Y,    KC_U,    KC_I,    KC_O,    KC_P,    TABS, \
+    KC_CAPS,  HOME_A,  HOME_S,  HOME_D,  HOME_F,    KC_G,       KC_H,  HOME_J,  HOME_K,  HOME_L,HOME_QUO,    RAYC, \
+   ONE_PASS,    PT_Z,    KC_X,    KC_C,    KC_V,    KC_B,       KC_N,    KC_M, KC_COMM,  KC_DOT, PT_SLSH,  LEADER, \
+                               MED_ESC, NAV_SPC,  KC_TAB,    SYM_ENT, NUM_BSPC
+
+/** \brief Numerals in numpad positions, right-hand mods. */
+//   ╭──────────────────────────────────────────────────────╮ ╭──────────────────────────────────────────────────────╮
+//     XXXXXXX, KC_LBRC, KC_7,    KC_8,    KC_9,    KC_RBRC,    XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,
+//   ├──────────────────────────────────────────────────────┤ ├──────────────────────────────────────────────────────┤
+//     XXXXXXX, KC_SCLN, KC_4,    KC_5,    KC_6,    KC_EQL,     XXXXXXX, KC_RSFT, KC_RGUI, KC_RALT, KC_RCTL, XXXXXXX,
+//   ├──────────────────────────────────────────────────────┤ ├──────────────────────────────────────────────────────┤
+//     XXXXXXX, KC_GRV,  KC_1,    KC_2,    KC_3,    KC_BSLS,    XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,
+//   ╰──────────────────────────────────────────────────────┤ ├──────────────────────────────────────────────────────╯
+//                                KC_DOT,  KC_0,    KC_MINS,    XXXXXXX, _______
+//                              ╰───────────────────────────╯ ╰──────────────────╯
+#define LAYOUT_LAYER_NUM                                                                                           \
+    XXXXXXX, KC_LBRC,    KC_7,    KC_8,    KC_9, KC_RBRC,    XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, \
+    XXXXXXX, KC_SCLN,    KC_4,    KC_5,    KC_6,  KC_EQL,    XXXXXXX, KC_RSFT, KC_RGUI, KC_RALT, KC_RCTL, XXXXXXX, \
+    XXXXXXX,  KC_GRV,    KC_1,    KC_2,    KC_3, KC_BSLS,    XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, \
+                                KC_DOT,    KC_0, KC_MINS,    XXXXXXX, _______
+
+/** \brief Shifted symbols mirroring the numeral layer, right-hand mods. */
+//   ╭──────────────────────────────────────────────────────╮ ╭──────────────────────────────────────────────────────╮
+//     XXXXXXX, LCRLY, S(KC_7),  S(KC_8),  S(KC_9), RCRLY,      XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,
+//   ├──────────────────────────────────────────────────────┤ ├──────────────────────────────────────────────────────┤
+//     XXXXXXX, CLN,   S(KC_4),  S(KC_5),  S(KC_6), KC_PPLS,    XXXXXXX, KC_RSFT, KC_RGUI, KC_RALT, KC_RCTL, XXXXXXX,
+//   ├──────────────────────────────────────────────────────┤ ├──────────────────────────────────────────────────────┤
+//     XXXXXXX, TLD,   S(KC_1),  S(KC_2),  S(KC_3),    PIPE,    XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,
+//   ╰──────────────────────────────────────────────────────┤ ├──────────────────────────────────────────────────────╯
+//                                LPAREN,  RPAREN,  UNDSCR,     _______, XXXXXXX
+//                              ╰───────────────────────────╯ ╰──────────────────╯
+#define LAYOUT_LAYER_SYM                                                                                           \
+    XXXXXXX,   LCRLY, S(KC_7), S(KC_8), S(KC_9),   RCRLY,    XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, \
+    XXXXXXX,     CLN, S(KC_4), S(KC_5), S(KC_6), KC_PPLS,    XXXXXXX, KC_RSFT, KC_RGUI, KC_RALT, KC_RCTL, XXXXXXX, \
+    XXXXXXX,     TLD, S(KC_1), S(KC_2), S(KC_3),    PIPE,    XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, \
+                                LPAREN,  RPAREN,  UNDSCR,    _______, XXXXXXX
+
+/** \brief Navigation keys on the right hand, left-hand mods. */
+//   ╭──────────────────────────────────────────────────────╮ ╭──────────────────────────────────────────────────────╮
+//     XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,    XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,
+//   ├──────────────────────────────────────────────────────┤ ├──────────────────────────────────────────────────────┤
+//     XXXXXXX, KC_LCTL, KC_LALT, KC_LGUI, KC_LSFT, XXXXXXX,    KC_LEFT, KC_DOWN, KC_UP,   KC_RGHT, CW_TOGG, XXXXXXX,
+//   ├──────────────────────────────────────────────────────┤ ├──────────────────────────────────────────────────────┤
+//     XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,    KC_END,  KC_PGDN, KC_PGUP, KC_HOME, XXXXXXX, XXXXXXX,
+//   ╰──────────────────────────────────────────────────────┤ ├──────────────────────────────────────────────────────╯
+//                                XXXXXXX, _______, XXXXXXX,    KC_ENT,  KC_BSPC
+//                              ╰───────────────────────────╯ ╰──────────────────╯
+#define LAYOUT_LAYER_NAV                                                                                           \
+    XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,    XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, \
+    XXXXXXX, KC_LCTL, KC_LALT, KC_LGUI, KC_LSFT, XXXXXXX,    KC_LEFT, KC_DOWN,   KC_UP, KC_RGHT, CW_TOGG, XXXXXXX, \
+    XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,     KC_END, KC_PGDN, KC_PGUP, KC_HOME, XXXXXXX, XXXXXXX, \
+                               XXXXXXX, _______, XXXXXXX,     KC_ENT, KC_BSPC
+
+/** \brief Media controls on the right hand, left-hand mods. */
+//   ╭──────────────────────────────────────────────────────╮ ╭──────────────────────────────────────────────────────╮
+//     XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,    XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,
+//   ├──────────────────────────────────────────────────────┤ ├──────────────────────────────────────────────────────┤
+//     XXXXXXX, KC_LCTL, KC_LALT, KC_LGUI, KC_LSFT, XXXXXXX,    KC_MPRV, KC_VOLD, KC_VOLU, KC_MNXT, XXXXXXX, XXXXXXX,
+//   ├──────────────────────────────────────────────────────┤ ├──────────────────────────────────────────────────────┤
+//     XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,    XXXXXXX, KC_MUTE, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,
+//   ╰──────────────────────────────────────────────────────┤ ├──────────────────────────────────────────────────────╯
+//                                _______, XXXXXXX, XXXXXXX,    KC_MSTP, KC_MPLY
+//                              ╰───────────────────────────╯ ╰──────────────────╯
+#define LAYOUT_LAYER_MEDIA                                                                                         \
+    XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,    XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, \
+    XXXXXXX, KC_LCTL, KC_LALT, KC_LGUI, KC_LSFT, XXXXXXX,    KC_MPRV, KC_VOLD, KC_VOLU, KC_MNXT, XXXXXXX, XXXXXXX, \
+    XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,    XXXXXXX, KC_MUTE, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, \
+                               _______, XXXXXXX, XXXXXXX,    KC_MSTP, KC_MPLY
+
+/** \brief Mouse emulation and pointer functions. */
+//   ╭──────────────────────────────────────────────────────╮ ╭──────────────────────────────────────────────────────╮
+//     QK_BOOT,  EE_CLR, XXXXXXX, XXXXXXX, DPI_MOD, S_D_MOD,    S_D_MOD, DPI_MOD, XXXXXXX, XXXXXXX,  EE_CLR, QK_BOOT,
+//   ├──────────────────────────────────────────────────────┤ ├──────────────────────────────────────────────────────┤
+//     XXXXXXX, KC_LCTL, KC_LALT, KC_LGUI, KC_LSFT, XXXXXXX,    XXXXXXX, KC_RSFT, KC_RGUI, KC_RALT, KC_RCTL, XXXXXXX,
+//   ├──────────────────────────────────────────────────────┤ ├──────────────────────────────────────────────────────┤
+//     XXXXXXX, _______, DRGSCRL, SNIPING, XXXXXXX, XXXXXXX,    XXXXXXX, XXXXXXX, SNIPING, DRGSCRL, _______, XXXXXXX,
+//   ╰──────────────────────────────────────────────────────┤ ├──────────────────────────────────────────────────────╯
+//                                KC_BTN2, KC_BTN1, KC_BTN3,    KC_BTN3, KC_BTN1
+//                              ╰───────────────────────────╯ ╰──────────────────╯
+#define LAYOUT_LAYER_POINTER                                                                                       \
+    QK_BOOT,  EE_CLR, XXXXXXX, XXXXXXX, DPI_MOD, S_D_MOD,    S_D_MOD, DPI_MOD, XXXXXXX, XXXXXXX,  EE_CLR, QK_BOOT, \
+    XXXXXXX, KC_LCTL, KC_LALT, KC_LGUI, KC_LSFT, XXXXXXX,    XXXXXXX, KC_RSFT, KC_RGUI, KC_RALT, KC_RCTL, XXXXXXX, \
+    XXXXXXX, _______, DRGSCRL, SNIPING, XXXXXXX, XXXXXXX,    XXXXXXX, XXXXXXX, SNIPING, DRGSCRL, _______, XXXXXXX, \
+                               KC_BTN2, KC_BTN1, KC_BTN3,    KC_BTN3, KC_BTN1
+
+/**
+ * \brief Per-layer bitmask of the keys defined on a layer.
+ *
+ * Expects the same 41 keycodes as `LAYOUT`, and sets bit `n` when the `n`-th
+ * keycode is neither `KC_NO` nor `KC_TRNS`.  Evaluated by the compiler, so the
+ * masks cost no runtime work and always match `keymaps[]`, eg.:
+ *
+ *     LAYER_KEYS_MASK(LAYOUT_LAYER_NUM)
+ */
+#define LAYER_KEY_BIT(KC, N) ((uint64_t)((KC) != KC_NO && (KC) != KC_TRNS) << (N))
+#define LAYER_KEYS_MASK_IMPL(                                                                                \
+    K000, K001, K002, K003, K004, K005, K006, K007, K008, K009, K010, K011,                                  \
+    K100, K101, K102, K103, K104, K105, K106, K107, K108, K109, K110, K111,                                  \
+    K200, K201, K202, K203, K204, K205, K206, K207, K208, K209, K210, K211,                                  \
+    K300, K301, K302, K303, K304)                                                                            \
+    (LAYER_KEY_BIT(K000, 0) | LAYER_KEY_BIT(K001, 1) | LAYER_KEY_BIT(K002, 2) | LAYER_KEY_BIT(K003, 3)       \
+     | LAYER_KEY_BIT(K004, 4) | LAYER_KEY_BIT(K005, 5) | LAYER_KEY_BIT(K006, 6) | LAYER_KEY_BIT(K007, 7)     \
+     | LAYER_KEY_BIT(K008, 8) | LAYER_KEY_BIT(K009, 9) | LAYER_KEY_BIT(K010, 10) | LAYER_KEY_BIT(K011, 11)   \
+     | LAYER_KEY_BIT(K100, 12) | LAYER_KEY_BIT(K101, 13) | LAYER_KEY_BIT(K102, 14) | LAYER_KEY_BIT(K103, 15) \
+     | LAYER_KEY_BIT(K104, 16) | LAYER_KEY_BIT(K105, 17) | LAYER_KEY_BIT(K106, 18) | LAYER_KEY_BIT(K107, 19) \
+     | LAYER_KEY_BIT(K108, 20) | LAYER_KEY_BIT(K109, 21) | LAYER_KEY_BIT(K110, 22) | LAYER_KEY_BIT(K111, 23) \
+     | LAYER_KEY_BIT(K200, 24) | LAYER_KEY_BIT(K201, 25) | LAYER_KEY_BIT(K202, 26) | LAYER_KEY_BIT(K203, 27) \
+     | LAYER_KEY_BIT(K204, 28) | LAYER_KEY_BIT(K205, 29) | LAYER_KEY_BIT(K206, 30) | LAYER_KEY_BIT(K207, 31) \
+     | LAYER_KEY_BIT(K208, 32) | LAYER_KEY_BIT(K209, 33) | LAYER_KEY_BIT(K210, 34) | LAYER_KEY_BIT(K211, 35) \
+     | LAYER_KEY_BIT(K300, 36) | LAYER_KEY_BIT(K301, 37) | LAYER_KEY_BIT(K302, 38) | LAYER_KEY_BIT(K303, 39) \
+     | LAYER_KEY_BIT(K304, 40))
+#define LAYER_KEYS_MASK(...) LAYER_KEYS_MASK_IMPL(__VA_ARGS__)
+
+#define LAYOUT_wrapper(...) LAYOUT(__VA_ARGS__)
+
 const uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {
-  [LAYER_BASE] = LAYOUT(
-  // ╭──────────────────────────────────────────────────────╮ ╭──────────────────────────────────────────────────────╮
-       TMUX,    KC_Q,    KC_W,    KC_E,    KC_R,    KC_T,       KC_Y,    KC_U,    KC_I,    KC_O,    KC_P,  TABS,
-  // ├──────────────────────────────────────────────────────┤ ├──────────────────────────────────────────────────────┤
-       KC_CAPS,  HOME_A,  HOME_S,  HOME_D,  HOME_F,    KC_G,       KC_H,  HOME_J,  HOME_K,  HOME_L,HOME_QUO, RAYC,
-  // ├──────────────────────────────────────────────────────┤ ├──────────────────────────────────────────────────────┤
-       ONE_PASS,   PT_Z,    KC_X,    KC_C,    KC_V,    KC_B,       KC_N,    KC_M, KC_COMM,  KC_DOT, PT_SLSH, LEADER,
-  // ╰──────────────────────────────────────────────────────┤ ├──────────────────────────────────────────────────────╯
-                                  MED_ESC, NAV_SPC, KC_TAB,    SYM_ENT, NUM_BSPC
-  //                            ╰───────────────────────────╯ ╰──────────────────╯
-  ),
-
-  [LAYER_NUM] = LAYOUT(
-  // ╭──────────────────────────────────────────────────────╮ ╭──────────────────────────────────────────────────────╮
-       XXXXXXX, KC_LBRC, KC_7,    KC_8,    KC_9,    KC_RBRC,    XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,
-  // ├──────────────────────────────────────────────────────┤ ├──────────────────────────────────────────────────────┤
-       XXXXXXX, KC_SCLN, KC_4,    KC_5,    KC_6,    KC_EQL,     XXXXXXX, KC_RSFT, KC_RGUI, KC_RALT, KC_RCTL, XXXXXXX,
-  // ├──────────────────────────────────────────────────────┤ ├──────────────────────────────────────────────────────┤
-       XXXXXXX, KC_GRV,  KC_1,    KC_2,    KC_3,    KC_BSLS,    XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,
-  // ╰──────────────────────────────────────────────────────┤ ├──────────────────────────────────────────────────────╯
-                                  KC_DOT,  KC_0,    KC_MINS,    XXXXXXX, _______
-  //                            ╰───────────────────────────╯ ╰──────────────────╯
-  ),
-
-  [LAYER_SYM] = LAYOUT(
-  // ╭──────────────────────────────────────────────────────╮ ╭──────────────────────────────────────────────────────╮
-       XXXXXXX, LCRLY, S(KC_7),  S(KC_8),  S(KC_9), RCRLY,      XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,
-  // ├──────────────────────────────────────────────────────┤ ├──────────────────────────────────────────────────────┤
-       XXXXXXX, CLN,   S(KC_4),  S(KC_5),  S(KC_6), KC_PPLS,    XXXXXXX, KC_RSFT, KC_RGUI, KC_RALT, KC_RCTL, XXXXXXX,
-  // ├──────────────────────────────────────────────────────┤ ├──────────────────────────────────────────────────────┤
-       XXXXXXX, TLD,   S(KC_1),  S(KC_2),  S(KC_3),    PIPE,    XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,
-  // ╰──────────────────────────────────────────────────────┤ ├──────────────────────────────────────────────────────╯
-                                  LPAREN,  RPAREN,  UNDSCR,     _______, XXXXXXX
-  //                            ╰───────────────────────────╯ ╰──────────────────╯
-  ),
-
-  [LAYER_NAV] = LAYOUT(
-  // ╭──────────────────────────────────────────────────────╮ ╭──────────────────────────────────────────────────────╮
-       XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,    XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,
-  // ├──────────────────────────────────────────────────────┤ ├──────────────────────────────────────────────────────┤
-       XXXXXXX, KC_LCTL, KC_LALT, KC_LGUI, KC_LSFT, XXXXXXX,    KC_LEFT, KC_DOWN, KC_UP,   KC_RGHT, CW_TOGG, XXXXXXX,
-  // ├──────────────────────────────────────────────────────┤ ├──────────────────────────────────────────────────────┤
-       XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,    KC_END,  KC_PGDN, KC_PGUP, KC_HOME, XXXXXXX, XXXXXXX,
-  // ╰──────────────────────────────────────────────────────┤ ├──────────────────────────────────────────────────────╯
-                                  XXXXXXX, _______, XXXXXXX,    KC_ENT,  KC_BSPC
-  //                            ╰───────────────────────────╯ ╰──────────────────╯
-  ),
-
-  [LAYER_MEDIA] = LAYOUT(
-  // ╭──────────────────────────────────────────────────────╮ ╭──────────────────────────────────────────────────────╮
-       XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,    XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,
-  // ├──────────────────────────────────────────────────────┤ ├──────────────────────────────────────────────────────┤
-       XXXXXXX, KC_LCTL, KC_LALT, KC_LGUI, KC_LSFT, XXXXXXX,    KC_MPRV, KC_VOLD, KC_VOLU, KC_MNXT, XXXXXXX, XXXXXXX,
-  // ├──────────────────────────────────────────────────────┤ ├──────────────────────────────────────────────────────┤
-       XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,    XXXXXXX, KC_MUTE, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,
-  // ╰──────────────────────────────────────────────────────┤ ├──────────────────────────────────────────────────────╯
-                                  _______, XXXXXXX, XXXXXXX,    KC_MSTP, KC_MPLY
-  //                            ╰───────────────────────────╯ ╰──────────────────╯
-  ),
-
-  [LAYER_POINTER] = LAYOUT(
-  // ╭──────────────────────────────────────────────────────╮ ╭──────────────────────────────────────────────────────╮
-       QK_BOOT,  EE_CLR, XXXXXXX, XXXXXXX, DPI_MOD, S_D_MOD,    S_D_MOD, DPI_MOD, XXXXXXX, XXXXXXX,  EE_CLR, QK_BOOT,
-  // ├──────────────────────────────────────────────────────┤ ├──────────────────────────────────────────────────────┤
-       XXXXXXX, KC_LCTL, KC_LALT, KC_LGUI, KC_LSFT, XXXXXXX,    XXXXXXX, KC_RSFT, KC_RGUI, KC_RALT, KC_RCTL, XXXXXXX,
-  // ├──────────────────────────────────────────────────────┤ ├──────────────────────────────────────────────────────┤
-       XXXXXXX, _______, DRGSCRL, SNIPING, XXXXXXX, XXXXXXX,    XXXXXXX, XXXXXXX, SNIPING, DRGSCRL, _______, XXXXXXX,
-  // ╰──────────────────────────────────────────────────────┤ ├──────────────────────────────────────────────────────╯
-                                  KC_BTN2, KC_BTN1, KC_BTN3,    KC_BTN3, KC_BTN1
-  //                            ╰───────────────────────────╯ ╰──────────────────╯
-  ),
+  [LAYER_BASE] = LAYOUT_wrapper(LAYOUT_LAYER_BASE),
+  [LAYER_NUM] = LAYOUT_wrapper(LAYOUT_LAYER_NUM),
+  [LAYER_SYM] = LAYOUT_wrapper(LAYOUT_LAYER_SYM),
+  [LAYER_NAV] = LAYOUT_wrapper(LAYOUT_LAYER_NAV),
+  [LAYER_MEDIA] = LAYOUT_wrapper(LAYOUT_LAYER_MEDIA),
+  [LAYER_POINTER] = LAYOUT_wrapper(LAYOUT_LAYER_POINTER),
 };
 // clang-format on
 
@@ -209,36 +289,160 @@ report_mouse_t pointing_device_task_user(report_mouse_t mouse_report) {
     if (abs(mouse_report.x) > CHARYBDIS_AUTO_POINTER_LAYER_TRIGGER_THRESHOLD || abs(mouse_report.y) > CHARYBDIS_AUTO_POINTER_LAYER_TRIGGER_THRESHOLD) {
         if (auto_pointer_layer_timer == 0) {
             layer_on(LAYER_POINTER);
-#        ifdef RGB_MATRIX_ENABLE
-            rgb_matrix_mode_noeeprom(RGB_MATRIX_NONE);
-            rgb_matrix_sethsv_noeeprom(HSV_GREEN);
-#        endif // RGB_MATRIX_ENABLE
         }
         auto_pointer_layer_timer = timer_read();
     }
     return mouse_report;
 }
 
-void matrix_scan_user(void) {
+static void auto_pointer_layer_task(void) {
     if (auto_pointer_layer_timer != 0 && TIMER_DIFF_16(timer_read(), auto_pointer_layer_timer) >= CHARYBDIS_AUTO_POINTER_LAYER_TRIGGER_TIMEOUT_MS) {
         auto_pointer_layer_timer = 0;
         layer_off(LAYER_POINTER);
-#        ifdef RGB_MATRIX_ENABLE
-        rgb_matrix_mode_noeeprom(RGB_MATRIX_DEFAULT_MODE);
-#        endif // RGB_MATRIX_ENABLE
     }
 }
 #    endif // CHARYBDIS_AUTO_POINTER_LAYER_TRIGGER_ENABLE
+#endif     // POINTING_DEVICE_ENABLE
+
+#ifdef RGB_MATRIX_ENABLE
+// clang-format off
+/** \brief Keys defined on each layer, in `LAYOUT` order. */
+static const uint64_t PROGMEM layer_keys[] = {
+  [LAYER_BASE] = LAYER_KEYS_MASK(LAYOUT_LAYER_BASE),
+  [LAYER_NUM] = LAYER_KEYS_MASK(LAYOUT_LAYER_NUM),
+  [LAYER_SYM] = LAYER_KEYS_MASK(LAYOUT_LAYER_SYM),
+  [LAYER_NAV] = LAYER_KEYS_MASK(LAYOUT_LAYER_NAV),
+  [LAYER_MEDIA] = LAYER_KEYS_MASK(LAYOUT_LAYER_MEDIA),
+  [LAYER_POINTER] = LAYER_KEYS_MASK(LAYOUT_LAYER_POINTER),
+};
+
+/** \brief 1-based `LAYOUT` position of each matrix key, 0 when unused. */
+static const uint8_t PROGMEM layout_positions[MATRIX_ROWS][MATRIX_COLS] = LAYOUT_wrapper(
+     1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12,
+    13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24,
+    25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36,
+                37, 38, 39, 40, 41
+);
+// clang-format on
+
+/** \brief Indicator hue for each layer. */
+static const uint8_t PROGMEM layer_hues[] = {
+    [LAYER_BASE]    = 190, // Purple-blue
+    [LAYER_NUM]     = 128, // Teal
+    [LAYER_SYM]     = 106, // Spring green
+    [LAYER_NAV]     = 10,  // Red-orange
+    [LAYER_MEDIA]   = 43,  // Yellow
+    [LAYER_POINTER] = 85,  // Green
+};
+
+#    define LED_COLOR_OFF 0
+#    define LED_COLOR_UNKNOWN 0xFF
+
+/** \brief `LAYOUT` position of each LED, see `layout_positions`. */
+static uint8_t led_positions[RGB_MATRIX_LED_COUNT];
+
+/** \brief What each LED currently shows: layer + 1, off, or unknown. */
+static uint8_t led_colors[RGB_MATRIX_LED_COUNT];
+
+static uint8_t indicator_val = 0;
+static uint8_t base_rgb_mode = 0;
+
+static void layer_indicators_init(void) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; ++row) {
+        for (uint8_t col = 0; col < MATRIX_COLS; ++col) {
+            uint8_t led = g_led_config.matrix_co[row][col];
+            if (led != NO_LED) {
+                led_positions[led] = pgm_read_byte(&layout_positions[row][col]);
+            }
+        }
+    }
+    memset(led_colors, LED_COLOR_UNKNOWN, sizeof(led_colors));
+}
+
+/** \brief Forget what the LEDs show, eg. after the effect cleared them. */
+void layer_indicators_invalidate(uint8_t led_min, uint8_t led_max) {
+    memset(&led_colors[led_min], LED_COLOR_UNKNOWN, led_max - led_min);
+}
+
+/**
+ * \brief Switch to the layer keys effect on any layer but the base one.
+ *
+ * The effect leaves the LED buffer alone once cleared, so the indicators only
+ * need to rewrite the LEDs whose color changed.  Only runs on the master, the
+ * mode reaches the slave with the rest of the RGB matrix config.
+ */
+static void layer_indicators_set_layer(uint8_t layer) {
+    uint8_t mode = rgb_matrix_get_mode();
+    if (layer != LAYER_BASE && mode != RGB_MATRIX_CUSTOM_LAYER_KEYS) {
+        base_rgb_mode = mode;
+        rgb_matrix_mode_noeeprom(RGB_MATRIX_CUSTOM_LAYER_KEYS);
+    } else if (layer == LAYER_BASE && mode == RGB_MATRIX_CUSTOM_LAYER_KEYS && base_rgb_mode != 0) {
+        rgb_matrix_mode_noeeprom(base_rgb_mode);
+    }
+}
+
+bool rgb_matrix_indicators_advanced_user(uint8_t led_min, uint8_t led_max) {
+    if (rgb_matrix_get_mode() != RGB_MATRIX_CUSTOM_LAYER_KEYS) {
+        return false;
+    }
+
+    uint8_t val = rgb_matrix_get_val();
+    if (val != indicator_val) {
+        // Brightness changed: every lit LED is stale.
+        indicator_val = val;
+        memset(led_colors, LED_COLOR_UNKNOWN, sizeof(led_colors));
+    }
+
+    // Both halves see `layer_state` (SPLIT_LAYER_STATE_ENABLE), whereas
+    // layer_state_set_user only runs on the master.
+    uint8_t  layer = get_highest_layer(layer_state | default_layer_state);
+    uint64_t keys  = 0;
+    uint8_t  color = LED_COLOR_OFF;
+    rgb_t    rgb   = {RGB_OFF};
+    if (layer < ARRAY_SIZE(layer_keys)) {
+        memcpy_P(&keys, &layer_keys[layer], sizeof(keys));
+        color = layer + 1;
+        rgb   = hsv_to_rgb((hsv_t){pgm_read_byte(&layer_hues[layer]), 255, val});
+    }
+
+    for (uint8_t i = led_min; i < led_max; ++i) {
+        uint8_t position = led_positions[i];
+        uint8_t wanted   = position != 0 && (keys >> (position - 1)) & 1 ? color : LED_COLOR_OFF;
+        if (led_colors[i] == wanted) {
+            continue;
+        }
+        led_colors[i] = wanted;
+        if (wanted == LED_COLOR_OFF) {
+            rgb_matrix_set_color(i, RGB_OFF);
+        } else {
+            rgb_matrix_set_color(i, rgb.r, rgb.g, rgb.b);
+        }
+    }
+    return false;
+}
+
+// Forward-declare this helper function since it is defined in rgb_matrix.c.
+void rgb_matrix_update_pwm_buffers(void);
+#endif // RGB_MATRIX_ENABLE
 
-#    ifdef CHARYBDIS_AUTO_SNIPING_ON_LAYER
 layer_state_t layer_state_set_user(layer_state_t state) {
+#ifdef RGB_MATRIX_ENABLE
+    layer_indicators_set_layer(get_highest_layer(state));
+#endif // RGB_MATRIX_ENABLE
+#if defined(POINTING_DEVICE_ENABLE) && defined(CHARYBDIS_AUTO_SNIPING_ON_LAYER)
     charybdis_set_pointer_sniping_enabled(layer_state_cmp(state, CHARYBDIS_AUTO_SNIPING_ON_LAYER));
+#endif // POINTING_DEVICE_ENABLE && CHARYBDIS_AUTO_SNIPING_ON_LAYER
     return state;
 }
-#    endif // CHARYBDIS_AUTO_SNIPING_ON_LAYER
-#endif     // POINTING_DEVICE_ENABLE
 
+void keyboard_post_init_user(void) {
 #ifdef RGB_MATRIX_ENABLE
-// Forward-declare this helper function since it is defined in rgb_matrix.c.
-void rgb_matrix_update_pwm_buffers(void);
-#endif
+    layer_indicators_init();
+#endif // RGB_MATRIX_ENABLE
+
+    // Periodic jobs, run from housekeeping_task_user within the loop budget.
+    user_task_register(leader_seq_task, 0, 0);
+#if defined(POINTING_DEVICE_ENABLE) && defined(CHARYBDIS_AUTO_POINTER_LAYER_TRIGGER_ENABLE)
+    user_task_register(auto_pointer_layer_task, 10, 0);
+#endif // POINTING_DEVICE_ENABLE && CHARYBDIS_AUTO_POINTER_LAYER_TRIGGER_ENABLE
+}
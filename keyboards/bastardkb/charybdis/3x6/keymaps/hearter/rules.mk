@@ -1,2 +1,5 @@
 VIA_ENABLE = no
 CAPS_WORD_ENABLE = yes
+
+# Blank effect backing the per-layer key indicators.
+RGB_MATRIX_CUSTOM_USER = yes
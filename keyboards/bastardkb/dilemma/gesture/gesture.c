@@ -0,0 +1,265 @@
+/**
+ * Copyright 2023 Hearter
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "gesture.h"
+
+#include <string.h>
+
+/*
+ * The driver only hands relative motion to user code, so touch-down and
+ * lift-off are inferred from the motion itself:
+ *
+ * - the first moving frame after an idle period is a touch-down;
+ * - a still frame right after fast motion is a lift-off, which starts a glide.
+ *   A finger stopping on the pad slows down over a few frames first, so the
+ *   last moving frame also has to be fast
+ *   (`DILEMMA_GESTURE_GLIDE_LIFT_SPEED`).  A finger stopped dead within a
+ *   single frame cannot be told from a lift-off and glides;
+ * - a still finger that moved slowly is lifted after
+ *   `DILEMMA_GESTURE_LIFT_TIMEOUT_MS`.
+ *
+ * Edges are found on a virtual pad position integrated from the motion and
+ * saturated at `DILEMMA_GESTURE_PAD_EXTENT`: pushing the finger against a side
+ * of the pad re-anchors it.  A touch starting in an edge zone only scrolls if
+ * its first `DILEMMA_GESTURE_EDGE_DECIDE_TRAVEL` counts run along that edge,
+ * otherwise the held motion is released as regular pointer motion.
+ */
+
+/** \brief Cap on glide steps per frame, keeps the per-call cost bounded. */
+#define GESTURE_MAX_GLIDE_STEPS 4
+
+/** \brief Largest per-frame delta fed to the Q8.8 velocity. */
+#define GESTURE_MAX_VELOCITY_DELTA 127
+
+static int16_t gesture_abs(int16_t value) {
+    return value < 0 ? -value : value;
+}
+
+static int16_t gesture_clamp(int32_t value, int16_t min, int16_t max) {
+    return value < min ? min : value > max ? max : (int16_t)value;
+}
+
+static int8_t gesture_clamp8(int16_t value) {
+    return (int8_t)gesture_clamp(value, -127, 127);
+}
+
+static bool gesture_in_right_edge(const gesture_state_t *state) {
+    return state->pos_x >= DILEMMA_GESTURE_PAD_EXTENT - DILEMMA_GESTURE_EDGE_WIDTH;
+}
+
+static bool gesture_in_bottom_edge(const gesture_state_t *state) {
+    return state->pos_y >= DILEMMA_GESTURE_PAD_EXTENT - DILEMMA_GESTURE_EDGE_WIDTH;
+}
+
+/** \brief Largest axis delta of a frame, saturated to a byte. */
+static uint8_t gesture_speed(int16_t x, int16_t y) {
+    int16_t speed = gesture_abs(x) > gesture_abs(y) ? gesture_abs(x) : gesture_abs(y);
+    return (uint8_t)gesture_clamp(speed, 0, UINT8_MAX);
+}
+
+/** \brief Exponential moving average of the finger speed, in Q8.8. */
+static int16_t gesture_track_velocity(int16_t velocity, int16_t delta) {
+    int32_t target = (int32_t)gesture_clamp(delta, -GESTURE_MAX_VELOCITY_DELTA, GESTURE_MAX_VELOCITY_DELTA) * 256;
+    return (int16_t)(velocity + (target - velocity) / 4);
+}
+
+/** \brief Emit the integer part of a Q8.8 step, keeping the remainder. */
+static int16_t gesture_take_step(int16_t *remainder, int16_t velocity) {
+    int16_t total = *remainder + velocity;
+    int16_t step  = total / 256;
+    *remainder    = total - step * 256;
+    return step;
+}
+
+/** \brief Drop button presses that bounce or that only stop a glide. */
+static uint8_t gesture_debounce_buttons(gesture_state_t *state, uint8_t buttons, uint16_t time) {
+    uint8_t pressed  = buttons & ~state->buttons;
+    uint8_t released = state->buttons & ~buttons;
+
+    for (uint8_t i = 0; i < 8; ++i) {
+        uint8_t bit = 1 << i;
+        if (state->released & bit && (uint16_t)(time - state->release_time[i]) >= DILEMMA_GESTURE_TAP_DEBOUNCE_MS) {
+            state->released &= ~bit;
+        }
+        if (released & bit) {
+            state->suppressed &= ~bit;
+            state->released |= bit;
+            state->release_time[i] = time;
+        } else if (pressed & bit && (state->released & bit || state->mode == GESTURE_GLIDING)) {
+            state->suppressed |= bit;
+        }
+    }
+
+    state->buttons = buttons;
+    return buttons & ~state->suppressed;
+}
+
+static void gesture_touch_down(gesture_state_t *state) {
+    state->vx         = 0;
+    state->vy         = 0;
+    state->travel_x   = 0;
+    state->travel_y   = 0;
+    state->last_speed = 0;
+    state->mode       = gesture_in_right_edge(state) || gesture_in_bottom_edge(state) ? GESTURE_EDGE_PENDING : GESTURE_TRACKING;
+}
+
+static void gesture_decide_edge(gesture_state_t *state, gesture_output_t *output) {
+    int16_t travel_x = gesture_abs(state->travel_x);
+    int16_t travel_y = gesture_abs(state->travel_y);
+    if (travel_x + travel_y < DILEMMA_GESTURE_EDGE_DECIDE_TRAVEL) {
+        return;
+    }
+
+    if (gesture_in_right_edge(state) && travel_y > travel_x) {
+        state->mode              = GESTURE_SCROLLING;
+        state->scroll_horizontal = false;
+        state->travel_x          = 0;
+    } else if (gesture_in_bottom_edge(state) && travel_x > travel_y) {
+        state->mode              = GESTURE_SCROLLING;
+        state->scroll_horizontal = true;
+        state->travel_y          = 0;
+    } else {
+        // Not an edge scroll: release the motion held back while deciding.
+        state->mode = GESTURE_TRACKING;
+        output->x   = state->travel_x;
+        output->y   = state->travel_y;
+    }
+}
+
+static void gesture_scroll(gesture_state_t *state, gesture_output_t *output) {
+    if (state->scroll_horizontal) {
+        int16_t steps = state->travel_x / DILEMMA_GESTURE_SCROLL_DIVISOR;
+        state->travel_x -= steps * DILEMMA_GESTURE_SCROLL_DIVISOR;
+        output->h = gesture_clamp8(steps);
+    } else {
+        int16_t steps = state->travel_y / DILEMMA_GESTURE_SCROLL_DIVISOR;
+        state->travel_y -= steps * DILEMMA_GESTURE_SCROLL_DIVISOR;
+        // Moving the finger down scrolls the content down.
+        output->v = gesture_clamp8(-steps);
+    }
+}
+
+static void gesture_handle_motion(gesture_state_t *state, const gesture_frame_t *frame, gesture_output_t *output) {
+    state->pos_x       = gesture_clamp((int32_t)state->pos_x + frame->x, 0, DILEMMA_GESTURE_PAD_EXTENT);
+    state->pos_y       = gesture_clamp((int32_t)state->pos_y + frame->y, 0, DILEMMA_GESTURE_PAD_EXTENT);
+    state->last_motion = frame->time;
+
+    if (state->mode == GESTURE_IDLE || state->mode == GESTURE_GLIDING) {
+        // A new touch, or a finger landing on the pad to catch a glide.
+        gesture_touch_down(state);
+    }
+
+    switch (state->mode) {
+        case GESTURE_EDGE_PENDING:
+            state->travel_x = gesture_clamp((int32_t)state->travel_x + frame->x, INT16_MIN, INT16_MAX);
+            state->travel_y = gesture_clamp((int32_t)state->travel_y + frame->y, INT16_MIN, INT16_MAX);
+            gesture_decide_edge(state, output);
+            if (state->mode == GESTURE_SCROLLING) {
+                gesture_scroll(state, output);
+            }
+            break;
+        case GESTURE_SCROLLING:
+            state->travel_x = gesture_clamp((int32_t)state->travel_x + frame->x, INT16_MIN, INT16_MAX);
+            state->travel_y = gesture_clamp((int32_t)state->travel_y + frame->y, INT16_MIN, INT16_MAX);
+            gesture_scroll(state, output);
+            break;
+        default:
+            output->x         = frame->x;
+            output->y         = frame->y;
+            state->vx         = gesture_track_velocity(state->vx, frame->x);
+            state->vy         = gesture_track_velocity(state->vy, frame->y);
+            state->last_speed = gesture_speed(frame->x, frame->y);
+            break;
+    }
+}
+
+static void gesture_glide(gesture_state_t *state, uint16_t time, gesture_output_t *output) {
+    uint16_t steps = (uint16_t)(time - state->last_step) / DILEMMA_GESTURE_GLIDE_INTERVAL_MS;
+    if (steps > GESTURE_MAX_GLIDE_STEPS) {
+        // Late frame: drop the backlog rather than jump.
+        state->last_step = time - GESTURE_MAX_GLIDE_STEPS * DILEMMA_GESTURE_GLIDE_INTERVAL_MS;
+        steps            = GESTURE_MAX_GLIDE_STEPS;
+    }
+
+    for (uint16_t i = 0; i < steps; ++i) {
+        output->x += gesture_take_step(&state->rx, state->vx);
+        output->y += gesture_take_step(&state->ry, state->vy);
+        state->vx = (int16_t)(((int32_t)state->vx * DILEMMA_GESTURE_GLIDE_FRICTION) / 256);
+        state->vy = (int16_t)(((int32_t)state->vy * DILEMMA_GESTURE_GLIDE_FRICTION) / 256);
+    }
+    state->last_step += steps * DILEMMA_GESTURE_GLIDE_INTERVAL_MS;
+
+    if (gesture_abs(state->vx) < 256 && gesture_abs(state->vy) < 256) {
+        // Less than a count per step left: the glide is over.
+        state->mode = GESTURE_IDLE;
+    }
+}
+
+static void gesture_handle_still(gesture_state_t *state, uint16_t time, gesture_output_t *output) {
+    bool lifted = (uint16_t)(time - state->last_motion) >= DILEMMA_GESTURE_LIFT_TIMEOUT_MS;
+
+    switch (state->mode) {
+        case GESTURE_TRACKING:
+            if (state->last_speed >= DILEMMA_GESTURE_GLIDE_LIFT_SPEED && (gesture_abs(state->vx) >= DILEMMA_GESTURE_GLIDE_THRESHOLD * 256 || gesture_abs(state->vy) >= DILEMMA_GESTURE_GLIDE_THRESHOLD * 256)) {
+                state->mode      = GESTURE_GLIDING;
+                state->rx        = 0;
+                state->ry        = 0;
+                state->last_step = time;
+            } else if (lifted) {
+                state->mode = GESTURE_IDLE;
+            } else {
+                // Resting finger: bleed off speed so a slow restart won't glide.
+                state->vx -= state->vx / 4;
+                state->vy -= state->vy / 4;
+            }
+            state->last_speed = 0;
+            break;
+        case GESTURE_EDGE_PENDING:
+        case GESTURE_SCROLLING:
+            if (lifted) {
+                state->mode = GESTURE_IDLE;
+            }
+            break;
+        case GESTURE_GLIDING:
+            gesture_glide(state, time, output);
+            break;
+        default:
+            break;
+    }
+}
+
+void gesture_init(gesture_state_t *state) {
+    memset(state, 0, sizeof(*state));
+    state->pos_x = DILEMMA_GESTURE_PAD_EXTENT / 2;
+    state->pos_y = DILEMMA_GESTURE_PAD_EXTENT / 2;
+}
+
+gesture_output_t gesture_process(gesture_state_t *state, const gesture_frame_t *frame) {
+    gesture_output_t output  = {0};
+    uint8_t          pressed = frame->buttons & ~state->buttons;
+
+    output.buttons = gesture_debounce_buttons(state, frame->buttons, frame->time);
+    if (pressed && state->mode == GESTURE_GLIDING) {
+        // A tap on the pad catches the glide, like a touch does.
+        state->mode = GESTURE_IDLE;
+    }
+    if (frame->x != 0 || frame->y != 0) {
+        gesture_handle_motion(state, frame, &output);
+    } else {
+        gesture_handle_still(state, frame->time, &output);
+    }
+    return output;
+}
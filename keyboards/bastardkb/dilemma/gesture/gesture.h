@@ -0,0 +1,138 @@
+/**
+ * Copyright 2023 Hearter
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+/**
+ * \brief Fixed-point trackpad gesture engine.
+ *
+ * Post-processes the relative frames the Cirque driver hands to
+ * `pointing_device_task_user`: inertial glide after lift-off, edge scrolling
+ * and tap-to-click debouncing.  Every call does a constant amount of work and
+ * all state lives in a caller-owned `gesture_state_t`.
+ *
+ * The engine only depends on the C standard headers so it can be compiled on
+ * the host and fed captured frames, see `tests/gesture_replay.c`.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** \brief Minimum average speed (counts per frame) at lift-off to start a glide. */
+#ifndef DILEMMA_GESTURE_GLIDE_THRESHOLD
+#    define DILEMMA_GESTURE_GLIDE_THRESHOLD 6
+#endif // DILEMMA_GESTURE_GLIDE_THRESHOLD
+
+/**
+ * \brief Minimum speed of the last moving frame to tell a lift-off from a stop.
+ *
+ * A finger that stops on the pad slows down over a few frames first, a lifted
+ * one is still moving on its last frame.
+ */
+#ifndef DILEMMA_GESTURE_GLIDE_LIFT_SPEED
+#    define DILEMMA_GESTURE_GLIDE_LIFT_SPEED DILEMMA_GESTURE_GLIDE_THRESHOLD
+#endif // DILEMMA_GESTURE_GLIDE_LIFT_SPEED
+
+/** \brief Glide velocity kept per step, out of 256. */
+#ifndef DILEMMA_GESTURE_GLIDE_FRICTION
+#    define DILEMMA_GESTURE_GLIDE_FRICTION 230
+#endif // DILEMMA_GESTURE_GLIDE_FRICTION
+
+/** \brief Time between two glide steps. */
+#ifndef DILEMMA_GESTURE_GLIDE_INTERVAL_MS
+#    define DILEMMA_GESTURE_GLIDE_INTERVAL_MS 10
+#endif // DILEMMA_GESTURE_GLIDE_INTERVAL_MS
+
+/** \brief Idle time after which a still finger is considered lifted. */
+#ifndef DILEMMA_GESTURE_LIFT_TIMEOUT_MS
+#    define DILEMMA_GESTURE_LIFT_TIMEOUT_MS 60
+#endif // DILEMMA_GESTURE_LIFT_TIMEOUT_MS
+
+/** \brief Extent of the virtual pad position used for edge detection. */
+#ifndef DILEMMA_GESTURE_PAD_EXTENT
+#    define DILEMMA_GESTURE_PAD_EXTENT 1024
+#endif // DILEMMA_GESTURE_PAD_EXTENT
+
+/** \brief Width of the right and bottom scroll edges. */
+#ifndef DILEMMA_GESTURE_EDGE_WIDTH
+#    define DILEMMA_GESTURE_EDGE_WIDTH 128
+#endif // DILEMMA_GESTURE_EDGE_WIDTH
+
+/** \brief Travel needed to tell an edge scroll from a pointer move. */
+#ifndef DILEMMA_GESTURE_EDGE_DECIDE_TRAVEL
+#    define DILEMMA_GESTURE_EDGE_DECIDE_TRAVEL 12
+#endif // DILEMMA_GESTURE_EDGE_DECIDE_TRAVEL
+
+/** \brief Pointer counts per emitted scroll step. */
+#ifndef DILEMMA_GESTURE_SCROLL_DIVISOR
+#    define DILEMMA_GESTURE_SCROLL_DIVISOR 24
+#endif // DILEMMA_GESTURE_SCROLL_DIVISOR
+
+/** \brief Window after a button release during which a new press is bounce. */
+#ifndef DILEMMA_GESTURE_TAP_DEBOUNCE_MS
+#    define DILEMMA_GESTURE_TAP_DEBOUNCE_MS 40
+#endif // DILEMMA_GESTURE_TAP_DEBOUNCE_MS
+
+/** \brief A single frame as reported by the trackpad driver. */
+typedef struct {
+    int16_t  x;
+    int16_t  y;
+    uint8_t  buttons;
+    uint16_t time; // Milliseconds, wraps around.
+} gesture_frame_t;
+
+/** \brief Engine output, merged back into the mouse report by the caller. */
+typedef struct {
+    int16_t x;
+    int16_t y;
+    int8_t  h;
+    int8_t  v;
+    uint8_t buttons;
+} gesture_output_t;
+
+typedef enum {
+    GESTURE_IDLE = 0,
+    GESTURE_EDGE_PENDING,
+    GESTURE_TRACKING,
+    GESTURE_SCROLLING,
+    GESTURE_GLIDING,
+} gesture_mode_t;
+
+typedef struct {
+    gesture_mode_t mode;
+    bool           scroll_horizontal;
+    int16_t        vx; // Q8.8 counts per frame.
+    int16_t        vy;
+    int16_t        rx; // Q8.8 glide remainders.
+    int16_t        ry;
+    int16_t        pos_x; // Virtual pad position.
+    int16_t        pos_y;
+    int16_t        travel_x; // Edge decision / scroll accumulators.
+    int16_t        travel_y;
+    uint8_t        last_speed; // Largest axis delta of the last moving frame.
+    uint16_t       last_motion;
+    uint16_t       last_step;
+    uint8_t        buttons;
+    uint8_t        released;   // Buttons with a pending debounce window.
+    uint8_t        suppressed; // Presses swallowed until their release.
+    uint16_t       release_time[8];
+} gesture_state_t;
+
+/** \brief Reset the engine, eg. on init or when the pad is disabled. */
+void gesture_init(gesture_state_t *state);
+
+/** \brief Process one frame; constant time, no allocation. */
+gesture_output_t gesture_process(gesture_state_t *state, const gesture_frame_t *frame);
@@ -26,11 +26,20 @@
 
 /* For OLED or other display if present */
 #ifdef OLED_ENABLE
-#    define OLED_TIMEOUT 0         // Never timeout
+#    define OLED_TIMEOUT 0         // Blanking is handled by the idle tiers below
 #    define OLED_BRIGHTNESS 255    // Maximum brightness
 #    define OLED_UPDATE_INTERVAL 100 // Reduce OLED bus churn
+#    define OLED_UPDATE_PROCESS_LIMIT 1 // Flush one dirty block per loop, bounds the I2C time per scan
 #endif
 
+/* Idle power tiers, measured from the last key or pointer activity */
+#define IDLE_SLOW_TIMEOUT_MS 30000       // Slow OLED refresh down
+#define IDLE_DIM_TIMEOUT_MS 60000        // Dim RGB and OLED
+#define IDLE_BLANK_TIMEOUT_MS 300000     // Blank RGB and OLED, skip OLED rendering
+#define IDLE_SLOW_OLED_INTERVAL_MS 1000  // OLED refresh period once slowed down
+#define IDLE_DIM_RGB_VAL 64              // RGB brightness once dimmed
+#define IDLE_DIM_OLED_BRIGHTNESS 32      // OLED brightness once dimmed
+
 /* RGB configuration */
 #ifdef RGBLIGHT_ENABLE
 #    define RGBLIGHT_ANIMATIONS // Enable all animations
@@ -51,9 +60,21 @@
 #define DEBOUNCE 3                // Reduce from default 5ms for faster response
 #define USB_POLLING_INTERVAL_MS 1 // 1000Hz polling for gaming/fast typing
 
+/* User task scheduler, see users/hearter/user_tasks.h */
+#define USER_TASKS_SCAN_BUDGET_MS 1 // One budgeted job per loop, cheap bookkeeping jobs always run
+
+/* Keycode lookup */
+#define KEYCODE_CACHE_ENABLE // Serve keymap lookups from a 154-byte RAM cache per layer state, see keycode_cache.h
+#if defined(KEYCODE_CACHE_ENABLE) && (defined(VIA_ENABLE) || defined(DYNAMIC_KEYMAP_ENABLE))
+#    error "KEYCODE_CACHE_ENABLE does not see keymap edits made at runtime, disable it with VIA or the dynamic keymap"
+#endif
+
 /* Tap dance configuration */
 #define TAPPING_TERM_TAP_DANCE 200 // Time window for tap dance (ms)
 
 /* Split keyboard specific */
 #define EE_HANDS
-#define SPLIT_TRANSPORT_MIRROR
+#define SPLIT_ACTIVITY_ENABLE // Share last activity so both halves follow the idle tiers
+#define SPLIT_TRANSACTION_IDS_USER USER_SYNC_SNAPSHOT // Layer, mods, last taps and loop rate for the slave OLED, replaces SPLIT_TRANSPORT_MIRROR
+#define SPLIT_OLED_OFFLOAD // Only the slave composes the status page; comment out to compare the master loop rate
+#define SPLIT_SNAPSHOT_KEEPALIVE_MS 500 // Resend an unchanged snapshot this often
@@ -0,0 +1,76 @@
+/**
+ * Copyright 2023 Hearter
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "keycode_cache.h"
+
+#ifdef KEYCODE_CACHE_ENABLE
+#    define KEYCODE_CACHE_KEYS (MATRIX_ROWS * MATRIX_COLS)
+#    define KEYCODE_CACHE_NONE 0xFF
+
+static uint16_t      keycode_cache[MATRIX_ROWS][MATRIX_COLS];
+static uint8_t       keycode_cache_source[MATRIX_ROWS][MATRIX_COLS]; // Layer defining the key, KEYCODE_CACHE_NONE when all are `_______`
+static uint8_t       keycode_cache_valid[(KEYCODE_CACHE_KEYS + 7) / 8];
+static layer_state_t keycode_cache_layers = 0;
+
+// Walk down the active layers until the key isn't transparent, like QMK does
+static void keycode_cache_resolve(layer_state_t layers, uint8_t row, uint8_t col) {
+    uint16_t keycode = KC_TRNS;
+    uint8_t  source  = KEYCODE_CACHE_NONE;
+    for (int8_t i = get_highest_layer(layers); i >= 0; i--) {
+        if (layers & ((layer_state_t)1 << i)) {
+            keycode = keycode_at_keymap_location(i, row, col);
+            if (keycode != KC_TRNS) {
+                source = i;
+                break;
+            }
+        }
+    }
+    keycode_cache[row][col]        = keycode;
+    keycode_cache_source[row][col] = source;
+}
+
+uint16_t keymap_key_to_keycode(uint8_t layer, keypos_t key) {
+    if (key.row >= MATRIX_ROWS || key.col >= MATRIX_COLS) {
+        return KC_NO;
+    }
+    layer_state_t layers = layer_state | default_layer_state;
+    if (layer >= keymap_layer_count() || !(layers & ((layer_state_t)1 << layer))) {
+        // Inactive layer, eg. the source layer of a key pressed under an older
+        // layer state: plain lookup.
+        return keycode_at_keymap_location(layer, key.row, key.col);
+    }
+
+    if (layers != keycode_cache_layers) {
+        memset(keycode_cache_valid, 0, sizeof(keycode_cache_valid));
+        keycode_cache_layers = layers;
+    }
+    uint8_t index = key.row * MATRIX_COLS + key.col;
+    if (!(keycode_cache_valid[index / 8] & (1 << (index % 8)))) {
+        keycode_cache_resolve(layers, key.row, key.col);
+        keycode_cache_valid[index / 8] |= 1 << (index % 8);
+    }
+
+    uint8_t source = keycode_cache_source[key.row][key.col];
+    if (layer == source) {
+        return keycode_cache[key.row][key.col];
+    }
+    if (source == KEYCODE_CACHE_NONE || layer > source) {
+        // Active layers above the one defining the key are all `_______` here
+        return KC_TRNS;
+    }
+    return keycode_at_keymap_location(layer, key.row, key.col);
+}
+#endif // KEYCODE_CACHE_ENABLE
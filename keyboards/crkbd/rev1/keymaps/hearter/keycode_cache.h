@@ -0,0 +1,36 @@
+/**
+ * Copyright 2023 Hearter
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "quantum.h"
+
+/**
+ * \brief Keymap lookups served from RAM for the current layer state.
+ *
+ * For every matrix position, the layer that defines the key under the active
+ * layers and its keycode are resolved on the first lookup after a layer
+ * change, with the same walk QMK does.  QMK's own walk down the active layers
+ * then gets `_______` for the layers above that one, and the keycode for it,
+ * without reading the keymap again.  A layer change only invalidates the
+ * cache, so momentary layer keys cost nothing extra.
+ *
+ * Every lookup returns exactly what the keymap holds for that layer, so the
+ * source layer QMK records on press still gives the same key on release
+ * whatever the layers did in between.  Keycodes are read through
+ * `keycode_at_keymap_location()`, but the cache cannot follow keymaps edited
+ * at runtime, hence the VIA and dynamic keymap check in `config.h`.
+ */
@@ -16,6 +16,17 @@
  */
 #include QMK_KEYBOARD_H
 
+#include "leader_seq.h"
+#include "send_string_packed.h"
+#include "user_tasks.h"
+#include "transactions.h"
+
+#ifdef OLED_ENABLE
+#    include "atomic_util.h"
+// Generated from oled_bitmaps.py by rules.mk
+#    include "oled_bitmaps.h"
+#endif
+
 enum corne_keymap_layers {
     LAYER_BASE = 0,
     LAYER_GAMING,
@@ -36,7 +47,7 @@ enum corne_keymap_layers {
 #define ONE_PASS G(KC_BSLS)
 #define TABS LCAG(KC_T)
 #define RAYC G(KC_SPC)
-#define LEADER TD(TD_GAMING_TOGGLE) // Tap dance: single tap for HYPR(KC_SPACE), double tap to toggle gaming layer
+#define LEADER TD(TD_GAMING_TOGGLE) // Tap dance: single tap starts a leader sequence, double tap toggles gaming layer
 #define LCRLY S(KC_LBRC)
 #define RCRLY S(KC_RBRC)
 #define CLN S(KC_SCLN)
@@ -72,8 +83,23 @@ user_config_t user_config;
 enum custom_keycodes {
     TMUX = SAFE_RANGE,
     RGB_TOG_EE, // Custom RGB toggle with EEPROM persistence
+    STATS,      // Type the scan loop and user task counters, then clear them
+};
+
+// Idle power tiers, entered after the IDLE_*_TIMEOUT_MS in config.h
+enum idle_tiers {
+    IDLE_ACTIVE = 0,
+    IDLE_SLOW,  // Slower OLED refresh
+    IDLE_DIM,   // Dimmed RGB and OLED
+    IDLE_BLANK, // RGB and OLED off, OLED rendering skipped
 };
 
+static uint8_t idle_tier = IDLE_ACTIVE;
+
+// Main loops per second last measured in each tier, typed out by STATS
+static uint16_t idle_tier_loops_per_s[IDLE_BLANK + 1];
+static uint32_t idle_tier_entered = 0;
+
 // Tap Dance definitions
 enum {
     TD_GAMING_TOGGLE, // Tap dance for gaming layer toggle
@@ -82,8 +108,15 @@ enum {
 
 // Forward declarations
 void set_rgb_for_layer(uint8_t layer);
+static void idle_task(void);
 #ifdef OLED_ENABLE
 static bool oled_is_left_side(void);
+static void oled_render_task(void);
+static void split_sync_task(void);
+static void split_snapshot_receive(uint8_t in_buflen, const void *in_data, uint8_t out_buflen, void *out_data);
+#endif
+#ifdef RGBLIGHT_ENABLE
+static void rgb_layer_task(void);
 #endif
 
 // Tap dance functions
@@ -100,9 +133,9 @@ void gaming_toggle_finished(tap_dance_state_t *state, void *user_data) {
 
 void gaming_toggle_reset(tap_dance_state_t *state, void *user_data) {
     if (state->count == 1) {
-        // Single tap: send HYPR+Space atomically. Avoid persistent
-        // register_mods()/unregister_mods() state from tap-dance timing paths.
-        tap_code16(HYPR(KC_SPACE));
+        // Single tap: start a leader sequence (see users/hearter/leader_seq.txt).
+        // Without a known sequence it still sends HYPR+Space for the launcher.
+        leader_seq_start();
     }
 }
 
@@ -117,6 +150,79 @@ void to_base_finished(tap_dance_state_t *state, void *user_data) {
 // Tap Dance definitions
 tap_dance_action_t tap_dance_actions[] = {[TD_GAMING_TOGGLE] = ACTION_TAP_DANCE_FN_ADVANCED(NULL, gaming_toggle_finished, gaming_toggle_reset), [TD_TO_BASE] = ACTION_TAP_DANCE_FN_ADVANCED(NULL, to_base_finished, NULL)};
 
+#ifdef OLED_ENABLE
+// Split work: the master only sends this snapshot, the slave turns it into
+// the status page, keylogger and typing stats
+#    define SNAPSHOT_KEYLOG_LEN 5
+
+typedef struct __attribute__((packed)) {
+    uint8_t  layer;
+    uint8_t  mods;
+    uint8_t  flags;
+    uint8_t  keylog[SNAPSHOT_KEYLOG_LEN]; // Last tapped basic keycodes, oldest first
+    uint16_t presses;
+    uint16_t loops_per_s; // Master main loop rate, see user_tasks_loop_stats()
+} split_snapshot_t;
+
+#    define SNAPSHOT_CAPS 0x01
+
+// Master: filled in as keys are processed. Slave: last snapshot received.
+static split_snapshot_t snapshot = {0};
+
+// Master: remember the tap for the slave's keylogger
+static void split_snapshot_record(uint16_t keycode, keyrecord_t *record) {
+    if (!record->event.pressed) {
+        return;
+    }
+    if (IS_QK_MOD_TAP(keycode) || IS_QK_LAYER_TAP(keycode)) {
+        if (record->tap.count == 0) {
+            return; // Held, not typed
+        }
+        keycode = IS_QK_MOD_TAP(keycode) ? QK_MOD_TAP_GET_TAP_KEYCODE(keycode) : QK_LAYER_TAP_GET_TAP_KEYCODE(keycode);
+    }
+    // Taps between two snapshots all reach the slave, up to the keylog length
+    if (IS_BASIC_KEYCODE(keycode)) {
+        memmove(snapshot.keylog, snapshot.keylog + 1, SNAPSHOT_KEYLOG_LEN - 1);
+        snapshot.keylog[SNAPSHOT_KEYLOG_LEN - 1] = keycode;
+    }
+    snapshot.presses++;
+}
+
+// Master: send the snapshot when it changed, and every keepalive period so a
+// slave that was reset catches up
+static void split_sync_task(void) {
+    static split_snapshot_t sent       = {0};
+    static uint16_t         sent_timer = 0;
+
+    snapshot.layer       = get_highest_layer(layer_state | default_layer_state);
+    snapshot.mods        = get_mods();
+    snapshot.flags       = (host_keyboard_led_state().caps_lock || is_caps_word_on()) ? SNAPSHOT_CAPS : 0;
+    snapshot.loops_per_s = user_tasks_loop_stats()->loops_per_s;
+
+    if (memcmp(&snapshot, &sent, sizeof(snapshot)) == 0 && timer_elapsed(sent_timer) < SPLIT_SNAPSHOT_KEEPALIVE_MS) {
+        return;
+    }
+    if (transaction_rpc_send(USER_SYNC_SNAPSHOT, sizeof(snapshot), &snapshot)) {
+        sent       = snapshot;
+        sent_timer = timer_read();
+    }
+}
+
+// Slave: runs from the split transport, so only copy
+static void split_snapshot_receive(uint8_t in_buflen, const void *in_data, uint8_t out_buflen, void *out_data) {
+    if (in_buflen == sizeof(snapshot)) {
+        memcpy(&snapshot, in_data, sizeof(snapshot));
+    }
+}
+
+// Consistent copy of the snapshot, the last one received on the slave
+static void split_snapshot_read(split_snapshot_t *state) {
+    ATOMIC_BLOCK_FORCEON {
+        *state = snapshot;
+    }
+}
+#endif
+
 // Initialize user EEPROM with default values
 void eeconfig_init_user(void) {
     // Initialize the user EEPROM with default values
@@ -148,17 +254,151 @@ void keyboard_post_init_user(void) {
         rgblight_disable();
     }
 #endif
+
+    // Periodic jobs, run from housekeeping_task_user within the loop budget
+    user_task_register(leader_seq_task, 0, 0);
+    user_task_register(idle_task, 50, 0);
+#ifdef OLED_ENABLE
+    user_task_register(oled_render_task, OLED_UPDATE_INTERVAL, 1);
+    if (is_keyboard_master()) {
+        user_task_register(split_sync_task, 10, 1);
+    } else {
+        transaction_register_rpc(USER_SYNC_SNAPSHOT, split_snapshot_receive);
+    }
+#endif
+#ifdef RGBLIGHT_ENABLE
+    user_task_register(rgb_layer_task, 10, 1);
+#endif
+}
+
+// Pick the idle tier from the time since the last key or pointer activity
+static uint8_t idle_tier_for(uint32_t idle_ms) {
+    if (idle_ms >= IDLE_BLANK_TIMEOUT_MS) {
+        return IDLE_BLANK;
+    }
+    if (idle_ms >= IDLE_DIM_TIMEOUT_MS) {
+        return IDLE_DIM;
+    }
+    if (idle_ms >= IDLE_SLOW_TIMEOUT_MS) {
+        return IDLE_SLOW;
+    }
+    return IDLE_ACTIVE;
+}
+
+// Apply RGB and OLED power for a tier; only runs on tier changes
+static void idle_apply_tier(uint8_t tier) {
+#ifdef RGBLIGHT_ENABLE
+    // The slave half mirrors the master's RGB state
+    if (is_keyboard_master() && user_config.rgb_enabled) {
+        if (tier == IDLE_BLANK) {
+            rgblight_disable_noeeprom();
+        } else {
+            rgblight_enable_noeeprom();
+            set_rgb_for_layer(get_highest_layer(layer_state));
+        }
+    }
+#endif
+
+#ifdef OLED_ENABLE
+    if (tier == IDLE_BLANK) {
+        oled_off();
+    } else {
+        oled_on();
+        oled_set_brightness(tier >= IDLE_DIM ? IDLE_DIM_OLED_BRIGHTNESS : OLED_BRIGHTNESS);
+    }
+#endif
+}
+
+// Step through the idle tiers. Activity is tracked by QMK before keys are
+// processed, so waking up never swallows the keystroke that caused it.
+static void idle_task(void) {
+    uint8_t tier = idle_tier_for(last_input_activity_elapsed());
+    if (tier != idle_tier) {
+        idle_tier         = tier;
+        idle_tier_entered = timer_read32();
+        idle_apply_tier(tier);
+    }
+    // The loop rate covers the last full second, skip the ones that started
+    // in the previous tier.
+    if (timer_elapsed32(idle_tier_entered) >= 2000) {
+        idle_tier_loops_per_s[tier] = user_tasks_loop_stats()->loops_per_s;
+    }
+}
+
+// Leader timeouts, idle tiers, OLED drawing and layer colors all run from the
+// scheduler so a slow job defers the others instead of delaying the scan
+void housekeeping_task_user(void) {
+    user_tasks_run();
+}
+
+// Type a decimal number without the padding of get_u16_str()
+static void send_u16(uint16_t value) {
+    const char *digits = get_u16_str(value, ' ');
+    while (*digits == ' ') {
+        digits++;
+    }
+    send_string_packed(digits);
+}
+
+// Type the scheduler counters on one line, eg. into a text editor.  Jobs are
+// numbered in registration order, see keyboard_post_init_user.
+static void send_stats_report(void) {
+    const user_tasks_loop_stats_t *loop = user_tasks_loop_stats();
+    SEND_STRING_PACKED("loops/s ");
+    send_u16(loop->loops_per_s);
+    SEND_STRING_PACKED(" worst loop ");
+    send_u16(loop->worst_loop_us);
+    SEND_STRING_PACKED("us tasks ");
+    send_u16(loop->worst_run_us);
+    SEND_STRING_PACKED("us;");
+
+    const user_task_stats_t *stats;
+    for (int8_t id = 0; (stats = user_task_stats(id)) != NULL; id++) {
+        SEND_STRING_PACKED(" job");
+        send_u16(id);
+        SEND_STRING_PACKED(" ");
+        send_u16(stats->worst_us);
+        SEND_STRING_PACKED("us over ");
+        send_u16(stats->overruns);
+        SEND_STRING_PACKED(" defer ");
+        send_u16(stats->deferrals);
+    }
+
+    SEND_STRING_PACKED("; loops/s active ");
+    send_u16(idle_tier_loops_per_s[IDLE_ACTIVE]);
+    SEND_STRING_PACKED(" slow ");
+    send_u16(idle_tier_loops_per_s[IDLE_SLOW]);
+    SEND_STRING_PACKED(" dim ");
+    send_u16(idle_tier_loops_per_s[IDLE_DIM]);
+    SEND_STRING_PACKED(" blank ");
+    send_u16(idle_tier_loops_per_s[IDLE_BLANK]);
+    user_tasks_stats_reset();
 }
 
 bool process_record_user(uint16_t keycode, keyrecord_t *record) {
+#ifdef OLED_ENABLE
+    split_snapshot_record(keycode, record);
+#endif
+
+    if (!process_record_leader_seq(keycode, record)) {
+        return false;
+    }
+
     switch (keycode) {
         case TMUX:
             if (record->event.pressed) {
                 // on press
-                SEND_STRING(SS_LALT("t") SS_DELAY(200) "`t");
+                SEND_STRING_PACKED(SS_LALT("t") SS_DELAY(200) "`t");
             }
             break;
 
+        case STATS:
+            if (record->event.pressed) {
+                send_stats_report();
+            }
+            return false;
+
+#ifdef RGBLIGHT_ENABLE
         case RGB_TOG_EE:
             if (record->event.pressed) {
                 // Toggle the RGB enabled state
@@ -176,6 +416,7 @@ bool process_record_user(uint16_t keycode, keyrecord_t *record) {
                 }
             }
             return false; // Skip all further processing of this key
+#endif
     }
     return true;
 }
@@ -191,16 +432,18 @@ static bool oled_is_left_side(void) {
 }
 
 oled_rotation_t oled_init_user(oled_rotation_t rotation) {
-    // Diagnostic: right OLED rotated lengthwise with bounded single-character writes.
+    // Right OLED is rotated lengthwise for the vertical banner.
     if (!oled_is_left_side()) {
         return OLED_ROTATION_90;
     }
     return rotation;
 }
 
+#endif
+
 // Custom bootmagic handling for RGB indicators
 void bootmagic_lite_reset_handler(void) {
-#    ifdef RGBLIGHT_ENABLE
+#ifdef RGBLIGHT_ENABLE
     // Flash all LEDs red as bootloader indication
     rgblight_enable_noeeprom();
 
@@ -215,64 +458,80 @@ void bootmagic_lite_reset_handler(void) {
     // Solid red for a moment before bootloader
     rgblight_setrgb(RGB_RED);
     wait_ms(100);
-#    endif
+#endif
 }
 
 // Define RGB colors for each layer
 void set_rgb_for_layer(uint8_t layer) {
-#    ifdef RGBLIGHT_ENABLE
+#ifdef RGBLIGHT_ENABLE
+    uint8_t hue;
     switch (layer) {
         case LAYER_BASE:
             // More purple shade for base layer
-            rgblight_sethsv_noeeprom(190, 255, 255); // Purple-blue
+            hue = 190; // Purple-blue
             break;
         case LAYER_NUM:
             // Teal/Cyan for number layer
-            rgblight_sethsv_noeeprom(128, 255, 255); // Teal
+            hue = 128; // Teal
             break;
         case LAYER_SYM:
             // Green for symbol layer
-            rgblight_sethsv_noeeprom(85, 255, 255); // Green
+            hue = 85; // Green
             break;
         case LAYER_NAV:
             // Red-orange for navigation layer
-            rgblight_sethsv_noeeprom(10, 255, 255); // Red-orange
+            hue = 10; // Red-orange
             break;
         case LAYER_MEDIA:
             // Bright yellow for media layer
-            rgblight_sethsv_noeeprom(43, 255, 255); // Bright yellow
+            hue = 43; // Bright yellow
             break;
         case LAYER_FN:
             // Purple for function layer
-            rgblight_sethsv_noeeprom(213, 255, 255); // Purple
+            hue = 213; // Purple
             break;
         case LAYER_GAMING:
             // Bright red for gaming layer
-            rgblight_sethsv_noeeprom(0, 255, 255); // Red
+            hue = 0; // Red
             break;
         default:
             // Magenta for unknown layers
-            rgblight_sethsv_noeeprom(234, 255, 255); // Magenta
+            hue = 234; // Magenta
             break;
     }
-#    endif
+    // Full brightness unless the idle tiers dimmed the lights
+    rgblight_sethsv_noeeprom(hue, 255, idle_tier >= IDLE_DIM ? IDLE_DIM_RGB_VAL : 255);
+#endif
 }
 
 // Layer state change callback
-layer_state_t layer_state_set_user(layer_state_t state) {
-#    ifdef RGBLIGHT_ENABLE
+#ifdef RGBLIGHT_ENABLE
+static uint8_t rgb_pending_layer = 0xFF; // Layer whose color still has to be applied
+
+// Apply the layer color off the key event path, see layer_state_set_user
+static void rgb_layer_task(void) {
+    if (rgb_pending_layer == 0xFF) {
+        return;
+    }
     // Only update RGB if it should be enabled (based on EEPROM setting)
     if (user_config.rgb_enabled) {
         // Enable RGB and set color based on active layer
         rgblight_enable_noeeprom();
-        set_rgb_for_layer(get_highest_layer(state));
+        set_rgb_for_layer(rgb_pending_layer);
     }
-#    endif
+    rgb_pending_layer = 0xFF;
+}
+#endif
+
+layer_state_t layer_state_set_user(layer_state_t state) {
+#ifdef RGBLIGHT_ENABLE
+    rgb_pending_layer = get_highest_layer(state);
+#endif
     return state;
 }
 
 bool shutdown_user(bool jump_to_bootloader) {
-#    ifdef RGBLIGHT_ENABLE
+#ifdef RGBLIGHT_ENABLE
     rgblight_enable_noeeprom();
 
     // Multiple flashes for visibility
@@ -286,160 +545,248 @@ bool shutdown_user(bool jump_to_bootloader) {
     // Final red for a moment
     rgblight_setrgb(RGB_RED);
     wait_ms(100);
-#    endif
+#endif
 
     return false;
 }
 
-// Print current layer with a visual indicator
-void render_layer_state(void) {
+#ifdef OLED_ENABLE
+
+// Slave status page on the rotated right OLED, five characters per row.
+
+// Print a layer name
+static void render_layer_state(uint8_t layer) {
     oled_write_P(PSTR("LAYER"), false);
-    oled_write_P(PSTR("\n"), false);
 
-    switch (get_highest_layer(layer_state)) {
+    switch (layer) {
         case LAYER_BASE:
-            oled_write_P(PSTR(" BASE "), false);
+            oled_write_P(PSTR("BASE "), false);
             break;
         case LAYER_NUM:
-            oled_write_P(PSTR(" NUM  "), false);
+            oled_write_P(PSTR("NUM  "), false);
             break;
         case LAYER_SYM:
-            oled_write_P(PSTR(" SYM  "), false);
+            oled_write_P(PSTR("SYM  "), false);
             break;
         case LAYER_NAV:
-            oled_write_P(PSTR(" NAV  "), false);
+            oled_write_P(PSTR("NAV  "), false);
             break;
         case LAYER_MEDIA:
-            oled_write_P(PSTR(" MEDIA"), false);
+            oled_write_P(PSTR("MEDIA"), false);
             break;
         case LAYER_FN:
-            oled_write_P(PSTR(" FUNC "), false);
+            oled_write_P(PSTR("FUNC "), false);
             break;
         case LAYER_GAMING:
-            oled_write_P(PSTR(" GAME "), false);
+            oled_write_P(PSTR("GAME "), false);
             break;
         default:
-            oled_write_P(PSTR("????  "), false);
+            oled_write_P(PSTR("???? "), false);
     }
 }
 
-// Print current modifier state
-void render_mod_status(uint8_t modifiers) {
-    oled_write_P(PSTR("\nMODS\n"), false);
-    oled_write_P(PSTR(" "), false);
+// Print a modifier state
+static void render_mod_status(uint8_t modifiers) {
+    oled_write_P(PSTR("MODS "), false);
     oled_write_P((modifiers & MOD_MASK_SHIFT) ? PSTR("S") : PSTR(" "), false);
     oled_write_P((modifiers & MOD_MASK_CTRL) ? PSTR("C") : PSTR(" "), false);
     oled_write_P((modifiers & MOD_MASK_ALT) ? PSTR("A") : PSTR(" "), false);
     oled_write_P((modifiers & MOD_MASK_GUI) ? PSTR("G") : PSTR(" "), false);
+    oled_write_P(PSTR(" "), false);
 }
 
-// Print caps lock indicator
-void render_caps_lock(bool caps_on) {
-    oled_write_P(PSTR("\nCAPS"), false);
-    oled_write_P(PSTR("\n "), false);
-    oled_write_P(caps_on ? PSTR("[ON]") : PSTR("    "), false);
+// Print caps lock / caps word indicator
+static void render_caps_lock(bool caps_on) {
+    oled_write_P(PSTR("CAPS "), false);
+    oled_write_P(caps_on ? PSTR("[ON] ") : PSTR("     "), false);
 }
 
-// Render keylogger (last pressed key)
-void render_keylogger(void) {
-    oled_write_P(PSTR("\nLAST"), false);
-    oled_write_P(PSTR("\n "), false);
+// Basic keycode to keylogger character
+// clang-format off
+static const char PROGMEM code_to_name[] = {
+    ' ', ' ', ' ', ' ', 'a', 'b', 'c', 'd', 'e', 'f',
+    'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n', 'o', 'p',
+    'q', 'r', 's', 't', 'u', 'v', 'w', 'x', 'y', 'z',
+    '1', '2', '3', '4', '5', '6', '7', '8', '9', '0',
+    'R', 'E', 'B', 'T', '_', '-', '=', '[', ']', '\\',
+    '#', ';', '\'', '`', ',', '.', '/',
+};
+// clang-format on
 
-    // This would need a key logger implementation
-    // For now just display a placeholder
-    oled_write_P(PSTR("KEY"), false);
+// Render keylogger (last tapped keys)
+static void render_keylogger(const uint8_t *keycodes) {
+    oled_write_P(PSTR("LAST "), false);
+    for (uint8_t i = 0; i < SNAPSHOT_KEYLOG_LEN; i++) {
+        oled_write_char(keycodes[i] < sizeof(code_to_name) ? pgm_read_byte(&code_to_name[keycodes[i]]) : '?', false);
+    }
 }
 
-// Main OLED task function
-bool oled_task_user(void) {
-    if (oled_is_left_side()) {
-        // Left OLED changes with layer/mod state; clear before redraw.
-        oled_clear();
-        // Left OLED - Show centered layer name and mods
-
-        // Layer name - centered
-        uint8_t layer = get_highest_layer(layer_state);
-        uint8_t layer_pos;
-
-        // First determine the position for proper centering
-        switch (layer) {
-            case LAYER_MEDIA:
-                layer_pos = 7; // Adjust for longer name (5 chars)
-                break;
-            case LAYER_FN:
-                layer_pos = 9; // Adjust for shorter name (2 chars)
-                break;
-            case LAYER_GAMING:
-                layer_pos = 8; // "GAME" is 4 chars
-                break;
-            default:
-                layer_pos = 8; // Default for 4-char layer names
-                break;
-        }
+// Taps per minute over a sliding window, sampled from the snapshot counter
+#    define STATS_SAMPLE_MS 2000
+#    define STATS_SAMPLES 5
 
-        // Now position cursor and display the text
-        oled_set_cursor(layer_pos, 0);
-        switch (layer) {
-            case LAYER_BASE:
-                oled_write_P(PSTR("BASE"), false);
-                break;
-            case LAYER_NUM:
-                oled_write_P(PSTR("NUM"), false);
-                break;
-            case LAYER_SYM:
-                oled_write_P(PSTR("SYM"), false);
-                break;
-            case LAYER_NAV:
-                oled_write_P(PSTR("NAV"), false);
-                break;
-            case LAYER_MEDIA:
-                oled_write_P(PSTR("MEDIA"), false);
-                break;
-            case LAYER_FN:
-                oled_write_P(PSTR("FN"), false);
-                break;
-            case LAYER_GAMING:
-                oled_write_P(PSTR("GAME"), false);
-                break;
-            default:
-                oled_write_P(PSTR("???"), false);
-        }
+static uint16_t stats_samples[STATS_SAMPLES];
+static uint8_t  stats_sample       = 0;
+static uint16_t stats_presses      = 0;
+static uint16_t stats_timer        = 0;
+static uint16_t stats_taps_per_min = 0;
 
-        // Show modifier status - centered
-        uint8_t mod_state = get_mods();
+// Returns true when a new sample changed the rate
+static bool stats_update(uint16_t presses) {
+    if (timer_elapsed(stats_timer) < STATS_SAMPLE_MS) {
+        return false;
+    }
+    stats_timer                 = timer_read();
+    stats_samples[stats_sample] = presses - stats_presses;
+    stats_presses               = presses;
+    stats_sample                = (stats_sample + 1) % STATS_SAMPLES;
+
+    uint16_t taps = 0;
+    for (uint8_t i = 0; i < STATS_SAMPLES; i++) {
+        taps += stats_samples[i];
+    }
+    taps *= 60000 / (STATS_SAMPLE_MS * STATS_SAMPLES);
+    if (taps == stats_taps_per_min) {
+        return false;
+    }
+    stats_taps_per_min = taps;
+    return true;
+}
 
-        char mods[5] = "    ";
-        if (mod_state & MOD_MASK_SHIFT) mods[0] = 'S';
-        if (mod_state & MOD_MASK_CTRL) mods[1] = 'C';
-        if (mod_state & MOD_MASK_ALT) mods[2] = 'A';
-        if (mod_state & MOD_MASK_GUI) mods[3] = 'G';
+// Render taps per minute and the master's main loops per second
+static void render_stats(uint16_t loops_per_s) {
+    oled_write_P(PSTR("TPM  "), false);
+    oled_write(get_u16_str(stats_taps_per_min, ' '), false);
+    oled_write_P(PSTR("LOOP "), false);
+    oled_write(get_u16_str(loops_per_s, ' '), false);
+}
 
-        oled_set_cursor(8, 2);
-        oled_write(mods, false);
-    } else {
-        oled_clear();
-
-        // Right OLED diagnostic: one character per row to avoid wrapping on the
-        // narrow 90° text grid.
-        oled_set_brightness(OLED_BRIGHTNESS);
-        oled_set_cursor(0, 0);
-        oled_write_P(PSTR("H"), false);
-        oled_set_cursor(0, 1);
-        oled_write_P(PSTR("E"), false);
-        oled_set_cursor(0, 2);
-        oled_write_P(PSTR("A"), false);
-        oled_set_cursor(0, 3);
-        oled_write_P(PSTR("R"), false);
-        oled_set_cursor(0, 4);
-        oled_write_P(PSTR("T"), false);
-        oled_set_cursor(0, 5);
-        oled_write_P(PSTR("E"), false);
-        oled_set_cursor(0, 6);
-        oled_write_P(PSTR("R"), false);
+static void render_status_text(const split_snapshot_t *state) {
+    oled_set_cursor(0, 0);
+    render_layer_state(state->layer);
+    oled_set_cursor(0, 3);
+    render_mod_status(state->mods);
+    oled_set_cursor(0, 6);
+    render_caps_lock(state->flags & SNAPSHOT_CAPS);
+    oled_set_cursor(0, 9);
+    render_keylogger(state->keylog);
+    oled_set_cursor(0, 12);
+    render_stats(state->loops_per_s);
+}
+
+// Copy a bitmap of `pages` rows of `width` bytes to a text cell position
+static void oled_blit_P(uint8_t col, uint8_t line, const char *bitmap, uint8_t width, uint8_t pages) {
+    for (uint8_t page = 0; page < pages; page++) {
+        oled_set_cursor(col, line + page);
+        oled_write_raw_P(bitmap + page * width, width);
+    }
+}
+
+// Left OLED: layer name centered on the top two pages
+static void render_layer_bitmap(uint8_t layer) {
+    const char *bitmap;
+    switch (layer) {
+        case LAYER_BASE:
+            bitmap = oled_layer_base;
+            break;
+        case LAYER_NUM:
+            bitmap = oled_layer_num;
+            break;
+        case LAYER_SYM:
+            bitmap = oled_layer_sym;
+            break;
+        case LAYER_NAV:
+            bitmap = oled_layer_nav;
+            break;
+        case LAYER_MEDIA:
+            bitmap = oled_layer_media;
+            break;
+        case LAYER_FN:
+            bitmap = oled_layer_fn;
+            break;
+        case LAYER_GAMING:
+            bitmap = oled_layer_game;
+            break;
+        default:
+            bitmap = oled_layer_unknown;
+            break;
     }
+    oled_blit_P(5, 0, bitmap, OLED_LAYER_NAME_WIDTH, OLED_BITMAP_PAGES);
+}
 
+// Left OLED: SCAG modifier glyphs centered on the bottom two pages
+static void render_mods_bitmap(uint8_t mod_state) {
+    oled_blit_P(6, 2, (mod_state & MOD_MASK_SHIFT) ? oled_mod_s : oled_mod_blank, OLED_GLYPH_WIDTH, OLED_BITMAP_PAGES);
+    oled_blit_P(8, 2, (mod_state & MOD_MASK_CTRL) ? oled_mod_c : oled_mod_blank, OLED_GLYPH_WIDTH, OLED_BITMAP_PAGES);
+    oled_blit_P(10, 2, (mod_state & MOD_MASK_ALT) ? oled_mod_a : oled_mod_blank, OLED_GLYPH_WIDTH, OLED_BITMAP_PAGES);
+    oled_blit_P(12, 2, (mod_state & MOD_MASK_GUI) ? oled_mod_g : oled_mod_blank, OLED_GLYPH_WIDTH, OLED_BITMAP_PAGES);
+}
+
+// Right OLED: the banner spans the full rotated width, so it is one write
+static void render_banner_bitmap(void) {
+    oled_set_cursor(0, 1);
+    oled_write_raw_P(oled_banner, sizeof(oled_banner));
+}
+
+// Main OLED task function
+bool oled_task_user(void) {
+    // Drawing is done by oled_render_task() on the scheduler, this only keeps
+    // the keyboard-level OLED code from drawing over it.
     return false;
 }
+
+// Draw into the OLED buffer, QMK flushes the dirty blocks
+static void oled_render_task(void) {
+    static uint16_t last_render = 0;
+
+    // Idle tiers: nothing to draw when blanked, and redraw less often when slowed
+    if (idle_tier == IDLE_BLANK) {
+        return;
+    }
+    if (idle_tier >= IDLE_SLOW && timer_elapsed(last_render) < IDLE_SLOW_OLED_INTERVAL_MS) {
+        return;
+    }
+    last_render = timer_read();
+
+    static split_snapshot_t drawn = {.layer = 0xFF};
+
+#    ifdef SPLIT_OLED_OFFLOAD
+    // A right master only draws its banner once, its loop stays free for
+    // input and the status page is composed on the slave. A left master
+    // still blits the layer and mods bitmaps, which only go out on changes.
+    static bool banner_drawn = false;
+    if (is_keyboard_master() && !oled_is_left_side()) {
+        if (!banner_drawn) {
+            banner_drawn = true;
+            render_banner_bitmap();
+        }
+        return;
+    }
+#    endif
+    // Without SPLIT_OLED_OFFLOAD a right master also composes the status page,
+    // from its own snapshot, which gives the master loop rate to compare against.
+
+    split_snapshot_t state;
+    split_snapshot_read(&state);
+    bool stats_changed = stats_update(state.presses);
+    if (!stats_changed && memcmp(&state, &drawn, sizeof(state)) == 0) {
+        return;
+    }
+
+    if (oled_is_left_side()) {
+        // Bitmaps only go out when what they show changed, and
+        // oled_write_raw_P() only marks blocks dirty when their bytes differ.
+        if (state.layer != drawn.layer) {
+            render_layer_bitmap(state.layer);
+        }
+        if (state.mods != drawn.mods || drawn.layer == 0xFF) {
+            render_mods_bitmap(state.mods);
+        }
+    } else {
+        render_status_text(&state);
+    }
+    drawn = state;
+}
 #endif
 
 // clang-format off
@@ -506,7 +853,7 @@ const uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {
 
   [LAYER_FN] = LAYOUT_split_3x6_3(
   // ╭──────────────────────────────────────────────────────╮ ╭──────────────────────────────────────────────────────╮
-       QK_BOOT, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,    XXXXXXX, KC_F7,   KC_F8,   KC_F9,   KC_F12,   QK_BOOT,
+       QK_BOOT, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, STATS,      XXXXXXX, KC_F7,   KC_F8,   KC_F9,   KC_F12,   QK_BOOT,
   // ├──────────────────────────────────────────────────────┤ ├──────────────────────────────────────────────────────┤
        XXXXXXX, KC_LCTL, KC_LALT, KC_LGUI, KC_LSFT, XXXXXXX,    XXXXXXX, KC_F4,   KC_F5,   KC_F6,   KC_F11,   XXXXXXX,
   // ├──────────────────────────────────────────────────────┤ ├──────────────────────────────────────────────────────┤
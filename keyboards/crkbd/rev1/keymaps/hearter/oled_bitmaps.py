@@ -0,0 +1,141 @@
+#!/usr/bin/env python3
+"""Prerender the crkbd OLED text into PROGMEM bitmaps.
+
+Usage: oled_bitmaps.py <oled_bitmaps.h>
+
+Glyphs come from the 5x7 font below, doubled to 10x14 pixels and centered in a
+12x16 cell: two 6px text columns wide and two 8px pages tall, so bitmaps line
+up with oled_set_cursor().  Bitmaps are stored page by page in the OLED buffer
+layout (one byte per column, least significant bit on top) and are copied
+with oled_write_raw_P().  The output file is only rewritten when its content
+changes, to keep incremental builds incremental.
+"""
+import os
+import sys
+
+FONT = {
+    'A': ['.###.', '#...#', '#...#', '#####', '#...#', '#...#', '#...#'],
+    'B': ['####.', '#...#', '#...#', '####.', '#...#', '#...#', '####.'],
+    'C': ['.###.', '#...#', '#....', '#....', '#....', '#...#', '.###.'],
+    'D': ['####.', '#...#', '#...#', '#...#', '#...#', '#...#', '####.'],
+    'E': ['#####', '#....', '#....', '####.', '#....', '#....', '#####'],
+    'F': ['#####', '#....', '#....', '####.', '#....', '#....', '#....'],
+    'G': ['.###.', '#...#', '#....', '#.###', '#...#', '#...#', '.####'],
+    'H': ['#...#', '#...#', '#...#', '#####', '#...#', '#...#', '#...#'],
+    'I': ['.###.', '..#..', '..#..', '..#..', '..#..', '..#..', '.###.'],
+    'M': ['#...#', '##.##', '#.#.#', '#.#.#', '#...#', '#...#', '#...#'],
+    'N': ['#...#', '##..#', '#.#.#', '#..##', '#...#', '#...#', '#...#'],
+    'R': ['####.', '#...#', '#...#', '####.', '#.#..', '#..#.', '#...#'],
+    'S': ['.####', '#....', '#....', '.###.', '....#', '....#', '####.'],
+    'T': ['#####', '..#..', '..#..', '..#..', '..#..', '..#..', '..#..'],
+    'U': ['#...#', '#...#', '#...#', '#...#', '#...#', '#...#', '.###.'],
+    'V': ['#...#', '#...#', '#...#', '#...#', '#...#', '.#.#.', '..#..'],
+    'Y': ['#...#', '#...#', '.#.#.', '..#..', '..#..', '..#..', '..#..'],
+    '?': ['.###.', '#...#', '....#', '...#.', '..#..', '.....', '..#..'],
+    ' ': ['.....'] * 7,
+}
+
+SCALE = 2
+CELL_WIDTH = 12  # Two text columns
+CELL_PAGES = 2
+
+# Layer names on the left OLED, all padded to the widest name.
+LAYER_NAMES = ['BASE', 'GAME', 'NUM', 'SYM', 'NAV', 'MEDIA', 'FN', '???']
+NAME_CELLS = max(len(name) for name in LAYER_NAMES)
+
+# Modifier glyphs on the left OLED, plus a blank one for released modifiers.
+MOD_GLYPHS = ['S', 'C', 'A', 'G', ' ']
+
+# Banner shown by the master half: on the right OLED, rotated 90 degrees, it is
+# 32px wide with one letter per row; on the left OLED it is a single line.
+BANNER = 'HEARTER'
+BANNER_WIDTH = 32
+
+
+def glyph_columns(char):
+    """Return the CELL_WIDTH columns of a glyph as 16-bit pixel masks."""
+    rows = FONT[char]
+    columns = [0] * CELL_WIDTH
+    for y, row in enumerate(rows):
+        for x, pixel in enumerate(row):
+            if pixel != '#':
+                continue
+            for dx in range(SCALE):
+                for dy in range(SCALE):
+                    columns[1 + x * SCALE + dx] |= 1 << (1 + y * SCALE + dy)
+    return columns
+
+
+def to_pages(columns, pages):
+    """Split 16-bit columns into page-major OLED buffer bytes."""
+    return [(column >> (8 * page)) & 0xFF for page in range(pages) for column in columns]
+
+
+def text_columns(text, cells):
+    """Columns for `text` centered in `cells` glyph cells."""
+    columns = []
+    for char in text:
+        columns += glyph_columns(char)
+    padding = (cells - len(text)) * CELL_WIDTH
+    return [0] * (padding // 2) + columns + [0] * (padding - padding // 2)
+
+
+def banner_bytes():
+    """One glyph per two pages, centered across the rotated 32px width."""
+    data = []
+    offset = (BANNER_WIDTH - CELL_WIDTH) // 2
+    for char in BANNER:
+        columns = [0] * offset + glyph_columns(char) + [0] * (BANNER_WIDTH - CELL_WIDTH - offset)
+        data += to_pages(columns, CELL_PAGES)
+    return data
+
+
+def symbol(text):
+    return {'???': 'unknown', ' ': 'blank'}.get(text, text.lower())
+
+
+def array(name, data):
+    out = [f'static const char PROGMEM {name}[{len(data)}] = {{']
+    for start in range(0, len(data), 16):
+        out.append('    ' + ', '.join(f'0x{byte:02x}' for byte in data[start:start + 16]) + ',')
+    out.append('};')
+    return out
+
+
+def render():
+    out = [
+        '// Generated by oled_bitmaps.py, do not edit.',
+        '#pragma once',
+        '',
+        f'#define OLED_BITMAP_PAGES {CELL_PAGES}',
+        f'#define OLED_GLYPH_WIDTH {CELL_WIDTH}',
+        f'#define OLED_GLYPH_COLUMNS {CELL_WIDTH // 6}',
+        f'#define OLED_LAYER_NAME_WIDTH {NAME_CELLS * CELL_WIDTH}',
+        f'#define OLED_BANNER_PAGES {len(BANNER) * CELL_PAGES}',
+        '',
+    ]
+    for name in LAYER_NAMES:
+        out += array(f'oled_layer_{symbol(name)}', to_pages(text_columns(name, NAME_CELLS), CELL_PAGES))
+    for glyph in MOD_GLYPHS:
+        out += array(f'oled_mod_{symbol(glyph)}', to_pages(glyph_columns(glyph), CELL_PAGES))
+    out += array('oled_banner', banner_bytes())
+    out.append('')
+    return '\n'.join(out)
+
+
+def main():
+    if len(sys.argv) != 2:
+        sys.exit(__doc__.strip().splitlines()[2])
+    target = sys.argv[1]
+    content = render()
+
+    if os.path.exists(target):
+        with open(target, encoding='utf-8') as current:
+            if current.read() == content:
+                return
+    with open(target, 'w', encoding='utf-8') as output:
+        output.write(content)
+
+
+if __name__ == '__main__':
+    main()
@@ -1,8 +1,16 @@
 VIA_ENABLE = no
 CAPS_WORD_ENABLE = yes
 
+# Keycode cache, enabled with KEYCODE_CACHE_ENABLE in config.h
+SRC += keycode_cache.c
+
 # OLED configuration
 OLED_ENABLE = yes
+# Layer names, mod glyphs and banner are prerendered into oled_bitmaps.h on every build
+HEARTER_KEYMAP_DIR := $(patsubst %/,%,$(dir $(lastword $(MAKEFILE_LIST))))
+ifneq ($(shell python3 $(HEARTER_KEYMAP_DIR)/oled_bitmaps.py $(HEARTER_KEYMAP_DIR)/oled_bitmaps.h && echo ok),ok)
+    $(error oled_bitmaps.py failed, oled_bitmaps.h was not updated)
+endif
 # OLED driver is automatically set to SSD1306
 
 # Disabled WPM counter
@@ -0,0 +1,92 @@
+#!/usr/bin/env python3
+"""Turn the crkbd hearter keymaps[] into a host header for keycode_cache_test.
+
+Usage: crkbd_keymap.py <keymap.c> <crkbd_keymap.h>
+
+Keycodes are only compared, never sent, so `_______` becomes KC_TRNS,
+`XXXXXXX` KC_NO and every other distinct keycode expression gets its own
+value.  The layer-tap keys of the base layer are listed with the layer they
+hold, for the hold-type-release benchmark.
+"""
+import re
+import sys
+
+LAYOUT_KEYS = 42
+
+
+def split_args(text):
+    args, depth, current = [], 0, ''
+    for char in text:
+        if char == ',' and depth == 0:
+            args.append(current.strip())
+            current = ''
+            continue
+        depth += char == '('
+        depth -= char == ')'
+        current += char
+    if current.strip():
+        args.append(current.strip())
+    return args
+
+
+def matrix_position(index):
+    """LAYOUT_split_3x6_3 argument to (row, col) of the 8x6 split matrix."""
+    if index < 36:
+        row, col = divmod(index, 12)
+        return (row, col) if col < 6 else (row + 4, 11 - col)
+    thumb = index - 36
+    return (3, 3 + thumb) if thumb < 3 else (7, 5 - (thumb - 3))
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit(__doc__.strip().splitlines()[2])
+    source, target = sys.argv[1:]
+    with open(source, encoding='utf-8') as keymap:
+        text = keymap.read()
+
+    enum = re.search(r'enum corne_keymap_layers \{(.*?)\};', text, re.S).group(1)
+    layers = [name.split('=')[0].strip() for name in enum.split(',') if name.strip()]
+    defines = dict(re.findall(r'^#define (\w+) (LT\(\w+, \w+\))', text, re.M))
+
+    body = text[text.index('const uint16_t PROGMEM keymaps'):]
+    body = re.sub(r'//[^\n]*', '', body[:body.index('\n};')])
+    values = {'_______': 'KC_TRNS', 'KC_TRNS': 'KC_TRNS', 'XXXXXXX': 'KC_NO', 'KC_NO': 'KC_NO'}
+    keymaps = {}
+    layer_taps = []
+    for name, args in re.findall(r'\[(\w+)\] = LAYOUT_split_3x6_3\((.*?)\n\s*\),', body, re.S):
+        keys = split_args(args)
+        if len(keys) != LAYOUT_KEYS:
+            sys.exit(f'{source}: {name} has {len(keys)} keys, expected {LAYOUT_KEYS}')
+        matrix = [['KC_NO'] * 6 for _ in range(8)]
+        for index, key in enumerate(keys):
+            if key not in values:
+                values[key] = f'0x{0x100 + len(values):04X}'
+            row, col = matrix_position(index)
+            matrix[row][col] = values[key]
+            held = re.match(r'LT\((\w+),', defines.get(key, key))
+            if name == 'LAYER_BASE' and held:
+                layer_taps.append((row, col, held.group(1)))
+        keymaps[name] = matrix
+
+    out = [
+        f'// Generated by crkbd_keymap.py from {source}, do not edit.',
+        '#pragma once',
+        '',
+        f'#define CRKBD_LAYERS {len(layers)}',
+        '',
+        'static const uint16_t crkbd_keymaps[CRKBD_LAYERS][8][6] = {',
+    ]
+    for index, name in enumerate(layers):
+        out.append(f'    [{index}] = {{ // {name}')
+        out += ['        {' + ', '.join(row) + '},' for row in keymaps[name]]
+        out.append('    },')
+    out += ['};', '', 'static const struct {', '    uint8_t row, col, layer;', '} crkbd_layer_taps[] = {']
+    out += [f'    {{{row}, {col}, {layers.index(layer)}}}, // {layer}' for row, col, layer in layer_taps]
+    out += ['};', '']
+    with open(target, 'w', encoding='utf-8') as output:
+        output.write('\n'.join(out))
+
+
+if __name__ == '__main__':
+    main()
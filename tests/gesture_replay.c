@@ -0,0 +1,159 @@
+/**
+ * Copyright 2023 Hearter
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Replays trackpad frames through the dilemma gesture engine.
+ *
+ * Usage: gesture_replay <file.frames>...
+ *
+ * A frame file has one `<time> <x> <y> <buttons>` line per frame, as printed
+ * by `DILEMMA_GESTURE_CAPTURE`, and `# expect <metric> <op> <value>` lines
+ * checked once the file is replayed.  Metrics:
+ *
+ * - motion: pointer counts sent on frames where the finger moved;
+ * - glide: pointer counts sent on still frames, ie. made up by the engine;
+ * - scroll_v, scroll_h: sum of the scroll steps sent;
+ * - clicks: button presses sent to the host.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "gesture.h"
+
+#define MAX_EXPECTS 16
+
+typedef struct {
+    char metric[16];
+    char op[3];
+    long value;
+} expect_t;
+
+typedef struct {
+    long motion;
+    long glide;
+    long scroll_v;
+    long scroll_h;
+    long clicks;
+} metrics_t;
+
+static long metric_value(const metrics_t *metrics, const char *name, int *found) {
+    *found = 1;
+    if (strcmp(name, "motion") == 0) return metrics->motion;
+    if (strcmp(name, "glide") == 0) return metrics->glide;
+    if (strcmp(name, "scroll_v") == 0) return metrics->scroll_v;
+    if (strcmp(name, "scroll_h") == 0) return metrics->scroll_h;
+    if (strcmp(name, "clicks") == 0) return metrics->clicks;
+    *found = 0;
+    return 0;
+}
+
+static int compare(long actual, const char *op, long value) {
+    if (strcmp(op, "=") == 0) return actual == value;
+    if (strcmp(op, "<") == 0) return actual < value;
+    if (strcmp(op, ">") == 0) return actual > value;
+    if (strcmp(op, "<=") == 0) return actual <= value;
+    if (strcmp(op, ">=") == 0) return actual >= value;
+    return -1;
+}
+
+static int replay(const char *path) {
+    FILE *file = fopen(path, "r");
+    if (file == NULL) {
+        perror(path);
+        return 1;
+    }
+
+    gesture_state_t state;
+    gesture_init(&state);
+
+    metrics_t metrics = {0};
+    expect_t  expects[MAX_EXPECTS];
+    int       expect_count = 0;
+    uint8_t   buttons      = 0;
+    int       frames       = 0;
+    int       line_no      = 0;
+    char      line[256];
+
+    while (fgets(line, sizeof(line), file) != NULL) {
+        line_no++;
+        expect_t expect;
+        if (sscanf(line, " # expect %15s %2s %ld", expect.metric, expect.op, &expect.value) == 3) {
+            if (expect_count == MAX_EXPECTS) {
+                fprintf(stderr, "%s:%d: too many expectations\n", path, line_no);
+                fclose(file);
+                return 1;
+            }
+            expects[expect_count++] = expect;
+            continue;
+        }
+        if (line[strspn(line, " \t\r\n")] == '\0' || line[strspn(line, " \t")] == '#') {
+            continue;
+        }
+
+        unsigned time, frame_buttons;
+        int      x, y;
+        if (sscanf(line, "%u %d %d %u", &time, &x, &y, &frame_buttons) != 4) {
+            fprintf(stderr, "%s:%d: expected `<time> <x> <y> <buttons>`\n", path, line_no);
+            fclose(file);
+            return 1;
+        }
+        gesture_frame_t  frame  = {.x = (int16_t)x, .y = (int16_t)y, .buttons = (uint8_t)frame_buttons, .time = (uint16_t)time};
+        gesture_output_t output = gesture_process(&state, &frame);
+        long             counts = labs(output.x) + labs(output.y);
+        if (x != 0 || y != 0) {
+            metrics.motion += counts;
+        } else {
+            metrics.glide += counts;
+        }
+        metrics.scroll_v += output.v;
+        metrics.scroll_h += output.h;
+        metrics.clicks += __builtin_popcount(output.buttons & ~buttons);
+        buttons = output.buttons;
+        frames++;
+    }
+    fclose(file);
+
+    printf("%-40s %4d frames  motion %5ld  glide %5ld  scroll_v %4ld  scroll_h %4ld  clicks %2ld\n", path, frames, metrics.motion, metrics.glide, metrics.scroll_v, metrics.scroll_h, metrics.clicks);
+
+    int failed = 0;
+    for (int i = 0; i < expect_count; i++) {
+        int  found;
+        long actual = metric_value(&metrics, expects[i].metric, &found);
+        int  ok     = found ? compare(actual, expects[i].op, expects[i].value) : -1;
+        if (ok < 0) {
+            fprintf(stderr, "%s: bad expectation `%s %s %ld`\n", path, expects[i].metric, expects[i].op, expects[i].value);
+            failed = 1;
+        } else if (!ok) {
+            fprintf(stderr, "%s: FAIL expected %s %s %ld, got %ld\n", path, expects[i].metric, expects[i].op, expects[i].value, actual);
+            failed = 1;
+        }
+    }
+    return failed;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s <file.frames>...\n", argv[0]);
+        return 2;
+    }
+    int failed = 0;
+    for (int i = 1; i < argc; i++) {
+        failed |= replay(argv[i]);
+    }
+    return failed;
+}
@@ -0,0 +1,219 @@
+/**
+ * Copyright 2023 Hearter
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Checks the crkbd keycode cache against QMK's stock keycode lookup, and counts
+ * the keymap reads it saves on the real crkbd keymap.
+ *
+ * Usage: keycode_cache_test
+ *
+ * Key events look keycodes up like QMK does.  On press, get_event_keycode()
+ * and then process_action() each walk down the active layers until a key is
+ * not `_______` (layer_switch_get_layer()) and read that layer again; the
+ * layer found is stored as the key's source layer.  On release, both read the
+ * source layer only, whatever the layer state is by then.  Keymap reads are
+ * PROGMEM reads on the keyboard, which is what the cache saves.
+ */
+#include <stdio.h>
+
+#include "keycode_cache.h"
+#include "crkbd_keymap.h"
+
+#define STATES 100000
+#define RANDOM_LAYERS 7
+#define TYPED_KEYS_MAX 4
+
+layer_state_t layer_state;
+layer_state_t default_layer_state;
+
+static const uint16_t (*keymaps)[MATRIX_ROWS][MATRIX_COLS];
+static uint8_t       layer_count;
+static unsigned long keymap_reads;
+
+uint8_t keymap_layer_count(void) {
+    return layer_count;
+}
+
+uint16_t keycode_at_keymap_location(uint8_t layer_num, uint8_t row, uint8_t column) {
+    ++keymap_reads;
+    return layer_num < layer_count ? keymaps[layer_num][row][column] : KC_TRNS;
+}
+
+static void use_keymap(const uint16_t (*layers)[MATRIX_ROWS][MATRIX_COLS], uint8_t count) {
+    keymaps             = layers;
+    layer_count         = count;
+    layer_state         = 0;
+    default_layer_state = 1;
+}
+
+static uint32_t rng_state = 0x2545F491;
+
+static uint32_t rng(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+/** \brief Mostly `_______` above the base layer, to stress the walk. */
+static uint16_t random_keymaps[RANDOM_LAYERS][MATRIX_ROWS][MATRIX_COLS];
+
+static void init_random_keymaps(void) {
+    for (uint8_t layer = 0; layer < RANDOM_LAYERS; ++layer) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; ++row) {
+            for (uint8_t col = 0; col < MATRIX_COLS; ++col) {
+                bool transparent                = layer > 0 && rng() % 10 < 6;
+                random_keymaps[layer][row][col] = transparent ? KC_TRNS : (uint16_t)(KC_A + rng() % 0xA0);
+            }
+        }
+    }
+}
+
+typedef uint16_t (*lookup_t)(uint8_t layer, keypos_t key);
+
+static uint16_t stock_key_to_keycode(uint8_t layer, keypos_t key) {
+    return keycode_at_keymap_location(layer, key.row, key.col);
+}
+
+static uint8_t switch_get_layer(lookup_t lookup, keypos_t key) {
+    layer_state_t layers = layer_state | default_layer_state;
+    for (int8_t i = 31; i >= 0; i--) {
+        if (layers & ((layer_state_t)1 << i) && lookup(i, key) != KC_TRNS) {
+            return i;
+        }
+    }
+    return 0;
+}
+
+/** \brief Keycode sent for a press, and the source layer QMK stores for it. */
+static uint16_t press(lookup_t lookup, keypos_t key, uint8_t *source) {
+    uint16_t keycode = 0;
+    for (uint8_t pass = 0; pass < 2; ++pass) {
+        *source = switch_get_layer(lookup, key);
+        keycode = lookup(*source, key);
+    }
+    return keycode;
+}
+
+static uint16_t release(lookup_t lookup, keypos_t key, uint8_t source) {
+    lookup(source, key);
+    return lookup(source, key);
+}
+
+static keypos_t random_key(void) {
+    return (keypos_t){.col = rng() % MATRIX_COLS, .row = rng() % MATRIX_ROWS};
+}
+
+/** \brief Press under one random layer state, release under the next. */
+static unsigned long check_random_states(const char *name) {
+    unsigned long mismatches = 0;
+    for (unsigned long i = 0; i < STATES; ++i) {
+        keypos_t key = random_key();
+        uint8_t  stock_source, cached_source;
+        uint16_t stock   = press(stock_key_to_keycode, key, &stock_source);
+        uint16_t cached  = press(keymap_key_to_keycode, key, &cached_source);
+        bool     pressed = stock == cached && stock_source == cached_source;
+
+        // Mostly single layer toggles, like momentary layer keys, and the odd
+        // unrelated jump.
+        layer_state = rng() % 4 == 0 ? rng() % (1 << layer_count) : layer_state ^ (1 << (rng() % layer_count));
+
+        bool released = release(stock_key_to_keycode, key, stock_source) == release(keymap_key_to_keycode, key, cached_source);
+        if (!pressed || !released) {
+            if (mismatches++ < 5) {
+                printf("    %s mismatch: key %u,%u, %s\n", name, key.row, key.col, pressed ? "release" : "press");
+            }
+        }
+    }
+    printf("%-8s %d random layer states, %lu mismatches\n", name, STATES, mismatches);
+    return mismatches;
+}
+
+/** \brief The stuck key from review: released after a layer under its source went off. */
+static unsigned long check_lower_layer_dropped(void) {
+    static uint16_t layers[4][MATRIX_ROWS][MATRIX_COLS];
+    layers[0][0][0] = KC_A;
+    layers[1][0][0] = KC_1;
+    layers[2][0][0] = KC_2;
+    layers[3][0][0] = KC_TRNS;
+    use_keymap((const uint16_t(*)[MATRIX_ROWS][MATRIX_COLS])layers, 4);
+
+    keypos_t key = {.col = 0, .row = 0};
+    uint8_t  source;
+    uint16_t pressed, released;
+    layer_state = 1 << 1 | 1 << 3;
+    pressed     = press(keymap_key_to_keycode, key, &source);
+    layer_state = 1 << 3;
+    released    = release(keymap_key_to_keycode, key, source);
+
+    bool failed = pressed != KC_1 || released != KC_1;
+    printf("%-8s press %04x, layer under it dropped, release %04x: %s\n", "stuck", pressed, released, failed ? "FAIL" : "ok");
+    return failed;
+}
+
+/** \brief Hold a layer tap, tap `typed` keys of its layer, release it. */
+static unsigned long hold_type_release(lookup_t lookup, uint8_t tap, uint8_t typed) {
+    keypos_t thumb = {.col = crkbd_layer_taps[tap].col, .row = crkbd_layer_taps[tap].row};
+    uint8_t  layer = crkbd_layer_taps[tap].layer;
+    uint8_t  thumb_source, source;
+
+    unsigned long reads = keymap_reads;
+    press(lookup, thumb, &thumb_source);
+    layer_state = (layer_state_t)1 << layer;
+    for (uint8_t index = 0, done = 0; index < MATRIX_ROWS * MATRIX_COLS && done < typed; ++index) {
+        keypos_t key = {.col = index % MATRIX_COLS, .row = index / MATRIX_COLS};
+        if (crkbd_keymaps[layer][key.row][key.col] == KC_NO || (key.row == thumb.row && key.col == thumb.col)) {
+            continue;
+        }
+        press(lookup, key, &source);
+        release(lookup, key, source);
+        ++done;
+    }
+    release(lookup, thumb, thumb_source);
+    layer_state = 0;
+    return keymap_reads - reads;
+}
+
+static void bench_crkbd(void) {
+    use_keymap(crkbd_keymaps, CRKBD_LAYERS);
+    printf("crkbd keymap reads per hold-type-release, averaged over the %zu base layer taps:\n", ARRAY_SIZE(crkbd_layer_taps));
+    printf("    %-12s %8s %8s %8s\n", "keys typed", "stock", "cached", "saved");
+    for (uint8_t typed = 1; typed <= TYPED_KEYS_MAX; typed *= 2) {
+        unsigned long stock_reads = 0, cached_reads = 0;
+        for (uint8_t tap = 0; tap < ARRAY_SIZE(crkbd_layer_taps); ++tap) {
+            stock_reads  += hold_type_release(stock_key_to_keycode, tap, typed);
+            cached_reads += hold_type_release(keymap_key_to_keycode, tap, typed);
+        }
+        double stock  = (double)stock_reads / ARRAY_SIZE(crkbd_layer_taps);
+        double cached = (double)cached_reads / ARRAY_SIZE(crkbd_layer_taps);
+        printf("    %-12u %8.1f %8.1f %8.1f\n", typed, stock, cached, stock - cached);
+    }
+}
+
+int main(void) {
+    unsigned long mismatches = 0;
+
+    init_random_keymaps();
+    use_keymap((const uint16_t(*)[MATRIX_ROWS][MATRIX_COLS])random_keymaps, RANDOM_LAYERS);
+    mismatches += check_random_states("random");
+    use_keymap(crkbd_keymaps, CRKBD_LAYERS);
+    mismatches += check_random_states("crkbd");
+    mismatches += check_lower_layer_dropped();
+
+    bench_crkbd();
+    return mismatches != 0;
+}
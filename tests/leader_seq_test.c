@@ -0,0 +1,158 @@
+/**
+ * Copyright 2023 Hearter
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Feeds key presses through the leader sequence matcher and checks what
+ * reaches the host, using the sequences from users/hearter/leader_seq.txt.
+ *
+ * Usage: leader_seq_test
+ */
+#include <stdio.h>
+#include <string.h>
+
+#include "leader_seq.h"
+#include "send_string_packed.h"
+
+#define FALLBACK "T(0f2c) "
+
+static uint16_t now;
+static char     sent[256];
+
+static void log_sent(const char *format, unsigned value) {
+    size_t used = strlen(sent);
+    snprintf(sent + used, sizeof(sent) - used, format, value);
+}
+
+uint16_t timer_read(void) {
+    return now;
+}
+
+uint16_t timer_elapsed(uint16_t last) {
+    return (uint16_t)(now - last);
+}
+
+void tap_code(uint8_t code) {
+    log_sent("t(%02x) ", code);
+}
+
+void tap_code16(uint16_t code) {
+    log_sent("T(%04x) ", code);
+}
+
+void send_string_packed_P(const char *string) {
+    size_t used = strlen(sent);
+    snprintf(sent + used, sizeof(sent) - used, "S(%s) ", string);
+}
+
+/** \brief Press and release `keycode`, logging `k(..)` when it is passed through. */
+static void press(uint16_t keycode, uint8_t tap_count) {
+    keyrecord_t record = {.event = {.pressed = true}, .tap = {.count = tap_count}};
+    if (process_record_leader_seq(keycode, &record)) {
+        log_sent("k(%04x) ", keycode);
+    }
+    record.event.pressed = false;
+    process_record_leader_seq(keycode, &record);
+    leader_seq_task();
+    now += 50;
+}
+
+/** \brief Let `ms` go by, running the task every millisecond like the scan loop. */
+static void idle(uint16_t ms) {
+    while (ms-- > 0) {
+        leader_seq_task();
+        ++now;
+    }
+}
+
+static int check(const char *name, const char *expected) {
+    int failed = strcmp(sent, expected) != 0;
+    printf("%-36s %s\n", name, failed ? "FAIL" : "ok");
+    if (failed) {
+        printf("    expected: %s\n    sent:     %s\n", expected, sent);
+    }
+    sent[0] = '\0';
+    idle(2000);
+    sent[0] = '\0';
+    return failed;
+}
+
+int main(void) {
+    int failed = 0;
+
+    leader_seq_start();
+    press(KC_B, 0);
+    press(KC_R, 0);
+    failed += check("letters go to the launcher", FALLBACK "k(0005) k(0015) ");
+
+    leader_seq_start();
+    idle(LEADER_SEQ_PREFIX_TIMEOUT_MS - 1);
+    failed += check("bare leader, before prefix timeout", "");
+
+    leader_seq_start();
+    idle(LEADER_SEQ_PREFIX_TIMEOUT_MS + 1);
+    failed += check("bare leader, after prefix timeout", FALLBACK);
+
+    leader_seq_start();
+    press(KC_COMM, 0);
+    press(KC_B, 0);
+    press(KC_X, 0);
+    failed += check("prefixed single key fires", "T(0d17) k(001b) ");
+
+    leader_seq_start();
+    press(KC_COMM, 0);
+    press(KC_T, 0);
+    press(KC_N, 0);
+    failed += check("prefixed sequence fires", "S(`c) ");
+
+    leader_seq_start();
+    press(KC_COMM, 0);
+    press(KC_T, 0);
+    press(KC_T, 0);
+    failed += check("sequence sends a string", "S(" SS_LALT("t") SS_DELAY(200) "`t) ");
+
+    leader_seq_start();
+    press(KC_COMM, 0);
+    press(KC_T, 0);
+    press(KC_E, 0);
+    failed += check("miss replays the prefix", FALLBACK "t(36) t(17) k(0008) ");
+
+    leader_seq_start();
+    press(KC_COMM, 0);
+    press(KC_W, 0);
+    idle(LEADER_SEQ_TIMEOUT_MS + 1);
+    failed += check("timeout replays the prefix", FALLBACK "t(36) t(1a) ");
+
+    leader_seq_start();
+    press(MT(0x02, KC_A), 0);
+    press(KC_COMM, 0);
+    press(LT(1, KC_W), 1);
+    press(KC_H, 0);
+    failed += check("holds pass through, taps match", "k(2204) T(0550) ");
+
+    leader_seq_start();
+    press(KC_COMM, 0);
+    press(KC_T, 0);
+    leader_seq_start();
+    press(KC_COMM, 0);
+    press(KC_B, 0);
+    failed += check("leader again replays the prefix", FALLBACK "t(36) t(17) T(0d17) ");
+
+    press(KC_B, 0);
+    failed += check("inactive matcher passes keys", "k(0005) ");
+
+    return failed != 0;
+}
@@ -0,0 +1,152 @@
+/**
+ * Copyright 2023 Hearter
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Minimal host stand-in for the parts of quantum.h used by the userspace code
+ * under test.  Keycode values match QMK; the functions that reach the host are
+ * implemented by each test.
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+#define PSTR(s) (s)
+#define pgm_read_byte(p) (*(const uint8_t *)(p))
+#define memcpy_P memcpy
+#define ARRAY_SIZE(a) (sizeof(a) / sizeof((a)[0]))
+
+enum {
+    KC_NO   = 0x00,
+    KC_TRNS = 0x01,
+    KC_A    = 0x04,
+    KC_B, KC_C, KC_D, KC_E, KC_F, KC_G, KC_H, KC_I, KC_J, KC_K, KC_L, KC_M,
+    KC_N, KC_O, KC_P, KC_Q, KC_R, KC_S, KC_T, KC_U, KC_V, KC_W, KC_X, KC_Y, KC_Z,
+    KC_1, KC_2, KC_3, KC_4, KC_5, KC_6, KC_7, KC_8, KC_9, KC_0,
+    KC_ENTER, KC_ESCAPE, KC_BACKSPACE, KC_TAB, KC_SPACE, KC_MINUS, KC_EQUAL,
+    KC_LEFT_BRACKET, KC_RIGHT_BRACKET, KC_BACKSLASH, KC_NONUS_HASH, KC_SEMICOLON,
+    KC_QUOTE, KC_GRAVE, KC_COMMA, KC_DOT, KC_SLASH,
+    KC_RIGHT = 0x4F,
+    KC_LEFT, KC_DOWN, KC_UP,
+    KC_LEFT_CTRL = 0xE0,
+    KC_LEFT_SHIFT, KC_LEFT_ALT, KC_LEFT_GUI, KC_RIGHT_CTRL, KC_RIGHT_SHIFT, KC_RIGHT_ALT, KC_RIGHT_GUI,
+};
+
+#define KC_ENT KC_ENTER
+#define KC_SPC KC_SPACE
+#define KC_BSLS KC_BACKSLASH
+#define KC_SCLN KC_SEMICOLON
+#define KC_GRV KC_GRAVE
+#define KC_COMM KC_COMMA
+#define KC_SLSH KC_SLASH
+#define KC_RGHT KC_RIGHT
+
+#define QK_LCTL 0x0100
+#define QK_LSFT 0x0200
+#define QK_LALT 0x0400
+#define QK_LGUI 0x0800
+#define LCTL(kc) (QK_LCTL | (kc))
+#define LSFT(kc) (QK_LSFT | (kc))
+#define LALT(kc) (QK_LALT | (kc))
+#define LGUI(kc) (QK_LGUI | (kc))
+#define G(kc) LGUI(kc)
+#define LCA(kc) (QK_LCTL | QK_LALT | (kc))
+#define LCAG(kc) (QK_LCTL | QK_LALT | QK_LGUI | (kc))
+#define HYPR(kc) (QK_LCTL | QK_LSFT | QK_LALT | QK_LGUI | (kc))
+
+#define QK_MOD_TAP 0x2000
+#define QK_MOD_TAP_MAX 0x3FFF
+#define QK_LAYER_TAP 0x4000
+#define QK_LAYER_TAP_MAX 0x4FFF
+#define MT(mod, kc) (QK_MOD_TAP | (((mod)&0x1F) << 8) | ((kc)&0xFF))
+#define LT(layer, kc) (QK_LAYER_TAP | (((layer)&0xF) << 8) | ((kc)&0xFF))
+#define IS_QK_MOD_TAP(code) ((code) >= QK_MOD_TAP && (code) <= QK_MOD_TAP_MAX)
+#define IS_QK_LAYER_TAP(code) ((code) >= QK_LAYER_TAP && (code) <= QK_LAYER_TAP_MAX)
+#define QK_MOD_TAP_GET_TAP_KEYCODE(kc) ((kc)&0xFF)
+#define QK_LAYER_TAP_GET_TAP_KEYCODE(kc) ((kc)&0xFF)
+#define IS_BASIC_KEYCODE(code) ((code) >= KC_A && (code) <= 0xA4)
+
+#define MOD_BIT(code) (1 << ((code)&0x07))
+#define IS_MODIFIER_KEYCODE(code) ((code) >= KC_LEFT_CTRL && (code) <= KC_RIGHT_GUI)
+
+/* send_string_keycodes.h */
+#define SS_QMK_PREFIX 1
+#define SS_TAP_CODE 1
+#define SS_DOWN_CODE 2
+#define SS_UP_CODE 3
+#define SS_DELAY_CODE 4
+#define X_LALT "\xe2"
+#define SS_TAP(keycode) "\1\1" keycode
+#define SS_DOWN(keycode) "\1\2" keycode
+#define SS_UP(keycode) "\1\3" keycode
+#define SS_DELAY(msecs) "\1\4" #msecs "|"
+#define SS_LALT(string) SS_DOWN(X_LALT) string SS_UP(X_LALT)
+
+/* send_string.h, the lookup tables are filled in by the test. */
+#define PGM_LOADBIT(mem, pos) ((pgm_read_byte(&((mem)[(pos) / 8])) >> ((pos) % 8)) & 0x01)
+extern uint8_t ascii_to_keycode_lut[128];
+extern uint8_t ascii_to_shift_lut[16];
+extern uint8_t ascii_to_altgr_lut[16];
+extern uint8_t ascii_to_dead_lut[16];
+void           send_char(char ascii_code);
+
+typedef uint32_t layer_state_t;
+
+typedef struct {
+    uint8_t col;
+    uint8_t row;
+} keypos_t;
+
+extern layer_state_t layer_state;
+extern layer_state_t default_layer_state;
+
+static inline uint8_t get_highest_layer(layer_state_t state) {
+    uint8_t layer = 0;
+    while (state >>= 1) {
+        ++layer;
+    }
+    return layer;
+}
+
+/* keymap_introspection.h */
+uint8_t  keymap_layer_count(void);
+uint16_t keycode_at_keymap_location(uint8_t layer_num, uint8_t row, uint8_t column);
+uint16_t keymap_key_to_keycode(uint8_t layer, keypos_t key);
+
+typedef struct {
+    struct {
+        bool pressed;
+    } event;
+    struct {
+        uint8_t count;
+    } tap;
+} keyrecord_t;
+
+uint16_t timer_read(void);
+uint16_t timer_elapsed(uint16_t last);
+void     wait_ms(uint16_t ms);
+void     tap_code(uint8_t code);
+void     tap_code16(uint16_t code);
+void     register_code(uint8_t code);
+void     unregister_code(uint8_t code);
+void     add_key(uint8_t key);
+void     del_key(uint8_t key);
+void     add_weak_mods(uint8_t mods);
+void     del_weak_mods(uint8_t mods);
+void     send_keyboard_report(void);
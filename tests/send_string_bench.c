@@ -0,0 +1,265 @@
+/**
+ * Copyright 2023 Hearter
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Counts the HID reports SEND_STRING_PACKED needs for the userspace macros,
+ * next to a model of stock SEND_STRING, and checks both type the same text.
+ *
+ * Usage: send_string_bench
+ *
+ * Each report is assumed to take one USB polling interval (1 ms), plus the
+ * SS_DELAY waits, which is what bounds macro typing speed on the keyboard.
+ * Host CPU time is not measured, it says nothing about the firmware.
+ */
+#include <stdio.h>
+#include <string.h>
+
+#include "send_string_packed.h"
+
+#define USB_POLL_MS 1
+#define MAX_KEYS 6
+
+uint8_t ascii_to_keycode_lut[128];
+uint8_t ascii_to_shift_lut[16];
+uint8_t ascii_to_altgr_lut[16];
+uint8_t ascii_to_dead_lut[16];
+
+/** \brief US ANSI layout, as in QMK's keymap_us lookup tables. */
+static const struct {
+    char    ascii;
+    uint8_t keycode;
+    bool    shifted;
+} us_keys[] = {
+    {'`', KC_GRAVE, false}, {'~', KC_GRAVE, true},  {'-', KC_MINUS, false}, {'_', KC_MINUS, true},
+    {'=', KC_EQUAL, false}, {'+', KC_EQUAL, true},  {' ', KC_SPACE, false}, {',', KC_COMMA, false},
+    {'<', KC_COMMA, true},  {'.', KC_DOT, false},   {'>', KC_DOT, true},    {'/', KC_SLASH, false},
+    {'?', KC_SLASH, true},  {';', KC_SEMICOLON, false}, {':', KC_SEMICOLON, true}, {'\'', KC_QUOTE, false},
+    {'"', KC_QUOTE, true},  {'\n', KC_ENTER, false},
+};
+
+static void init_luts(void) {
+    for (char c = 'a'; c <= 'z'; ++c) {
+        ascii_to_keycode_lut[(uint8_t)c]           = KC_A + (c - 'a');
+        ascii_to_keycode_lut[(uint8_t)(c - 0x20)] = KC_A + (c - 'a');
+        ascii_to_shift_lut[(c - 0x20) / 8] |= 1 << ((c - 0x20) % 8);
+    }
+    for (char c = '1'; c <= '9'; ++c) {
+        ascii_to_keycode_lut[(uint8_t)c] = KC_1 + (c - '1');
+    }
+    ascii_to_keycode_lut['0'] = KC_0;
+    for (size_t i = 0; i < ARRAY_SIZE(us_keys); ++i) {
+        uint8_t c               = (uint8_t)us_keys[i].ascii;
+        ascii_to_keycode_lut[c] = us_keys[i].keycode;
+        if (us_keys[i].shifted) {
+            ascii_to_shift_lut[c / 8] |= 1 << (c % 8);
+        }
+    }
+}
+
+// Keyboard report state and what the host made of the reports so far.
+static uint8_t  real_mods, weak_mods;
+static uint8_t  keys[MAX_KEYS];
+static uint8_t  host_keys[MAX_KEYS];
+static unsigned reports, waited_ms, presses, max_keys_down;
+static char     typed[256];
+
+static bool has_key(const uint8_t *set, uint8_t key) {
+    for (uint8_t i = 0; i < MAX_KEYS; ++i) {
+        if (set[i] == key) return true;
+    }
+    return false;
+}
+
+/** \brief Append what the host types for `key` pressed with `mods`. */
+static void host_type(uint8_t key, uint8_t mods) {
+    bool   shifted = mods & (MOD_BIT(KC_LEFT_SHIFT) | MOD_BIT(KC_RIGHT_SHIFT));
+    size_t used    = strlen(typed);
+    char   ascii   = 0;
+    ++presses;
+    for (uint8_t c = 1; c < 128 && ascii == 0; ++c) {
+        if (ascii_to_keycode_lut[c] == key && (bool)PGM_LOADBIT(ascii_to_shift_lut, c) == shifted) {
+            ascii = (char)c;
+        }
+    }
+    uint8_t other_mods = mods & ~(MOD_BIT(KC_LEFT_SHIFT) | MOD_BIT(KC_RIGHT_SHIFT));
+    if (other_mods != 0 || ascii == 0) {
+        snprintf(typed + used, sizeof(typed) - used, "{%02x-%02x}", mods, key);
+    } else {
+        snprintf(typed + used, sizeof(typed) - used, "%c", ascii);
+    }
+}
+
+void send_keyboard_report(void) {
+    uint8_t  mods = real_mods | weak_mods;
+    unsigned down = 0;
+    for (uint8_t i = 0; i < MAX_KEYS; ++i) {
+        if (keys[i] == KC_NO) continue;
+        ++down;
+        if (!has_key(host_keys, keys[i])) {
+            host_type(keys[i], mods);
+        }
+    }
+    memcpy(host_keys, keys, sizeof(keys));
+    if (down > max_keys_down) max_keys_down = down;
+    ++reports;
+}
+
+void wait_ms(uint16_t ms) {
+    waited_ms += ms;
+}
+
+void add_key(uint8_t key) {
+    for (uint8_t i = 0; i < MAX_KEYS; ++i) {
+        if (keys[i] == KC_NO) {
+            keys[i] = key;
+            return;
+        }
+    }
+}
+
+void del_key(uint8_t key) {
+    for (uint8_t i = 0; i < MAX_KEYS; ++i) {
+        if (keys[i] == key) keys[i] = KC_NO;
+    }
+}
+
+void add_weak_mods(uint8_t mods) {
+    weak_mods |= mods;
+}
+
+void del_weak_mods(uint8_t mods) {
+    weak_mods &= ~mods;
+}
+
+void register_code(uint8_t code) {
+    if (IS_MODIFIER_KEYCODE(code)) {
+        real_mods |= MOD_BIT(code);
+    } else {
+        add_key(code);
+    }
+    send_keyboard_report();
+}
+
+void unregister_code(uint8_t code) {
+    if (IS_MODIFIER_KEYCODE(code)) {
+        real_mods &= ~MOD_BIT(code);
+    } else {
+        del_key(code);
+    }
+    send_keyboard_report();
+}
+
+void tap_code(uint8_t code) {
+    register_code(code);
+    unregister_code(code);
+}
+
+/** \brief Stock send_char(), with the default TAP_CODE_DELAY of 0. */
+void send_char(char ascii_code) {
+    uint8_t keycode = pgm_read_byte(&ascii_to_keycode_lut[(uint8_t)ascii_code]);
+    bool    shifted = PGM_LOADBIT(ascii_to_shift_lut, (uint8_t)ascii_code);
+    bool    altgred = PGM_LOADBIT(ascii_to_altgr_lut, (uint8_t)ascii_code);
+    if (shifted) register_code(KC_LEFT_SHIFT);
+    if (altgred) register_code(KC_RIGHT_ALT);
+    tap_code(keycode);
+    if (altgred) unregister_code(KC_RIGHT_ALT);
+    if (shifted) unregister_code(KC_LEFT_SHIFT);
+    if (PGM_LOADBIT(ascii_to_dead_lut, (uint8_t)ascii_code)) tap_code(KC_SPACE);
+}
+
+/** \brief Stock send_string(), escape codes included. */
+static void stock_send_string(const char *string) {
+    for (; *string != '\0'; ++string) {
+        if (*string != SS_QMK_PREFIX) {
+            send_char(*string);
+            continue;
+        }
+        char code = *++string;
+        if (code == SS_TAP_CODE) {
+            tap_code((uint8_t)*++string);
+        } else if (code == SS_DOWN_CODE) {
+            register_code((uint8_t)*++string);
+        } else if (code == SS_UP_CODE) {
+            unregister_code((uint8_t)*++string);
+        } else if (code == SS_DELAY_CODE) {
+            uint16_t ms = 0;
+            while (string[1] >= '0' && string[1] <= '9') {
+                ms = ms * 10 + (*++string - '0');
+            }
+            if (string[1] == '|') ++string;
+            wait_ms(ms);
+        }
+    }
+}
+
+typedef struct {
+    unsigned reports, ms, presses, max_keys_down;
+    char     typed[256];
+} run_t;
+
+static run_t run(void (*sender)(const char *), const char *string) {
+    real_mods = weak_mods = 0;
+    memset(keys, 0, sizeof(keys));
+    memset(host_keys, 0, sizeof(host_keys));
+    reports = waited_ms = presses = max_keys_down = 0;
+    typed[0] = '\0';
+
+    sender(string);
+
+    run_t result = {.reports = reports, .ms = reports * USB_POLL_MS + waited_ms, .presses = presses, .max_keys_down = max_keys_down};
+    memcpy(result.typed, typed, sizeof(typed));
+    return result;
+}
+
+static const struct {
+    const char *name;
+    const char *string;
+} snippets[] = {
+    {"TMUX", SS_LALT("t") SS_DELAY(200) "`t"},
+    {"leader ,tn", "`c"},
+    {"leader ,tl", "`n"},
+    {"leader ,th", "`p"},
+    {"abcdefgh", "abcdefgh"},
+    {"helloWorld", "helloWorld"},
+};
+
+int main(void) {
+    int failed = 0;
+    init_luts();
+
+    printf("%-12s %5s  %14s  %14s  %12s  %12s\n", "snippet", "chars", "stock reports", "packed reports", "stock char/s", "packed char/s");
+    for (size_t i = 0; i < ARRAY_SIZE(snippets); ++i) {
+        run_t    stock  = run(stock_send_string, snippets[i].string);
+        run_t    packed = run(send_string_packed, snippets[i].string);
+        unsigned chars  = packed.presses;
+
+        printf("%-12s %5u  %14u  %14u  %12.0f  %12.0f\n", snippets[i].name, chars, stock.reports, packed.reports, 1000.0 * chars / stock.ms, 1000.0 * chars / packed.ms);
+        if (strchr(snippets[i].string, SS_QMK_PREFIX) == NULL && strcmp(packed.typed, snippets[i].string) != 0) {
+            printf("    FAIL typed `%s`\n", packed.typed);
+            failed = 1;
+        }
+        if (strcmp(stock.typed, packed.typed) != 0) {
+            printf("    FAIL typed `%s`, stock SEND_STRING types `%s`\n", packed.typed, stock.typed);
+            failed = 1;
+        }
+        if (packed.max_keys_down > 1) {
+            printf("    FAIL %u keys down in one report\n", packed.max_keys_down);
+            failed = 1;
+        }
+    }
+    return failed;
+}
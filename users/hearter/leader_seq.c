@@ -0,0 +1,113 @@
+/**
+ * Copyright 2023 Hearter
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "leader_seq.h"
+#include "send_string_packed.h"
+#include "leader_seq_trie.h"
+
+static bool     leader_seq_active = false;
+static uint8_t  leader_seq_node   = 0;
+static uint16_t leader_seq_timer  = 0;
+
+// Keys matched so far, replayed to the launcher when the sequence goes nowhere.
+static uint8_t leader_seq_keys[LEADER_SEQ_MAX_DEPTH];
+static uint8_t leader_seq_depth = 0;
+
+static uint8_t leader_seq_find_child(uint8_t node, uint8_t keycode) {
+    for (uint8_t child = pgm_read_byte(&leader_seq_trie[node].child); child != 0; child = pgm_read_byte(&leader_seq_trie[child].sibling)) {
+        if (pgm_read_byte(&leader_seq_trie[child].keycode) == keycode) {
+            return child;
+        }
+    }
+    return 0;
+}
+
+/** \brief Open the host launcher and type the keys matched so far into it. */
+static void leader_seq_fallback(void) {
+    leader_seq_active = false;
+    tap_code16(LEADER_SEQ_FALLBACK);
+    for (uint8_t i = 0; i < leader_seq_depth; ++i) {
+        tap_code(leader_seq_keys[i]);
+    }
+    leader_seq_depth = 0;
+}
+
+void leader_seq_start(void) {
+    if (leader_seq_active) {
+        // LEADER again mid-sequence: hand over what was typed so far first.
+        leader_seq_fallback();
+    }
+    leader_seq_active = true;
+    leader_seq_node   = 0;
+    leader_seq_depth  = 0;
+    leader_seq_timer  = timer_read();
+}
+
+bool process_record_leader_seq(uint16_t keycode, keyrecord_t *record) {
+    if (!leader_seq_active || !record->event.pressed) {
+        return true;
+    }
+
+    // Tap-hold keys take part with their tap keycode; holds (mods, layers)
+    // pass through so sequences can be typed from any layer.
+    if (IS_QK_MOD_TAP(keycode) || IS_QK_LAYER_TAP(keycode)) {
+        if (record->tap.count == 0) {
+            return true;
+        }
+        keycode = IS_QK_MOD_TAP(keycode) ? QK_MOD_TAP_GET_TAP_KEYCODE(keycode) : QK_LAYER_TAP_GET_TAP_KEYCODE(keycode);
+    }
+    if (!IS_BASIC_KEYCODE(keycode)) {
+        return true;
+    }
+
+    uint8_t next = leader_seq_find_child(leader_seq_node, keycode);
+    if (next == 0) {
+        // Not a sequence: hand what was typed so far, and this key, over to
+        // the host launcher.
+        leader_seq_fallback();
+        return true;
+    }
+
+    leader_seq_keys[leader_seq_depth++] = keycode;
+    leader_seq_node                     = next;
+    leader_seq_timer                    = timer_read();
+    if (pgm_read_byte(&leader_seq_trie[next].child) == 0) {
+        leader_seq_active = false;
+        leader_seq_run_action(pgm_read_byte(&leader_seq_trie[next].action));
+    }
+    return false;
+}
+
+void leader_seq_task(void) {
+    if (!leader_seq_active) {
+        return;
+    }
+    // Only the sequence prefix is waited for after LEADER, so LEADER on its own
+    // opens the launcher almost right away.
+    uint16_t timeout = leader_seq_node == 0 ? LEADER_SEQ_PREFIX_TIMEOUT_MS : LEADER_SEQ_TIMEOUT_MS;
+    if (timer_elapsed(leader_seq_timer) < timeout) {
+        return;
+    }
+
+    uint8_t action = pgm_read_byte(&leader_seq_trie[leader_seq_node].action);
+    if (action == 0) {
+        leader_seq_fallback();
+    } else {
+        // Sequence that is also the prefix of a longer one.
+        leader_seq_active = false;
+        leader_seq_run_action(action);
+    }
+}
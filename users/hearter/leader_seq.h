@@ -0,0 +1,74 @@
+/**
+ * Copyright 2023 Hearter
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "quantum.h"
+
+/**
+ * \brief Leader sequences resolved in firmware.
+ *
+ * After `leader_seq_start()`, keys are matched one at a time against a PROGMEM
+ * trie generated from `leader_seq.txt`.  Each key costs one walk over the
+ * children of the current node and the RAM used is the current node plus the
+ * keys typed so far, so adding sequences only grows flash.
+ *
+ * Every sequence starts with the same prefix key (`,`, see `leader_seq.txt`),
+ * so letters typed after LEADER always reach the host launcher: any other first
+ * key sends `LEADER_SEQ_FALLBACK` and is passed through, and LEADER on its own
+ * sends it after `LEADER_SEQ_PREFIX_TIMEOUT_MS`.
+ *
+ * Sequences without a longer continuation fire as soon as their last key is
+ * typed.  When a started sequence does not match, or times out without an
+ * action, `LEADER_SEQ_FALLBACK` is sent followed by the keys typed so far, and
+ * the key that broke the match is passed through, so nothing typed is lost.
+ */
+
+/** \brief Time allowed between LEADER and the sequence prefix key. */
+#ifndef LEADER_SEQ_PREFIX_TIMEOUT_MS
+#    define LEADER_SEQ_PREFIX_TIMEOUT_MS 200
+#endif // LEADER_SEQ_PREFIX_TIMEOUT_MS
+
+/** \brief Time allowed between two keys of a sequence. */
+#ifndef LEADER_SEQ_TIMEOUT_MS
+#    define LEADER_SEQ_TIMEOUT_MS 1000
+#endif // LEADER_SEQ_TIMEOUT_MS
+
+/** \brief Sent when LEADER is not followed by a known sequence. */
+#ifndef LEADER_SEQ_FALLBACK
+#    define LEADER_SEQ_FALLBACK HYPR(KC_SPACE)
+#endif // LEADER_SEQ_FALLBACK
+
+typedef struct {
+    uint8_t keycode; // Basic keycode matched by this node.
+    uint8_t child;   // First child, 0 when none.
+    uint8_t sibling; // Next node sharing the same parent, 0 when none.
+    uint8_t action;  // Action fired when a sequence ends here, 0 when none.
+} leader_seq_node_t;
+
+/**
+ * \brief Start matching a sequence, called when LEADER is tapped.
+ *
+ * A sequence still in progress gets the fallback treatment first, so its keys
+ * reach the launcher instead of being dropped.
+ */
+void leader_seq_start(void);
+
+/** \brief Feed a key event; returns false when the key was consumed. */
+bool process_record_leader_seq(uint16_t keycode, keyrecord_t *record);
+
+/** \brief Fire or cancel a pending sequence once it timed out. */
+void leader_seq_task(void);
@@ -0,0 +1,137 @@
+#!/usr/bin/env python3
+"""Generate the PROGMEM leader trie from leader_seq.txt.
+
+Usage: leader_seq_trie.py <leader_seq.txt> <leader_seq_trie.h>
+
+Every sequence starts with PREFIX, so any other key typed after LEADER goes
+straight to the host launcher.  Node 0 is the root.  Every node stores the keycode it matches, its first child,
+its next sibling and the action fired when a sequence ends on it, so matching
+one key only walks the children of the current node.  The output file is only
+rewritten when its content changes, to keep incremental builds incremental.
+"""
+import os
+import sys
+
+KEYCODES = {c: 'KC_' + c.upper() for c in 'abcdefghijklmnopqrstuvwxyz0123456789'}
+KEYCODES.update({',': 'KC_COMM', '.': 'KC_DOT', '/': 'KC_SLSH', ';': 'KC_SCLN'})
+
+MAX_NODES = 255
+PREFIX = ','
+
+
+class Node:
+    def __init__(self, keycode):
+        self.keycode = keycode
+        self.children = []
+        self.action = 0
+        self.index = 0
+
+
+def fail(path, line_no, message):
+    sys.exit(f'{path}:{line_no}: {message}')
+
+
+def parse(path):
+    sequences = []
+    with open(path, encoding='utf-8') as table:
+        for line_no, line in enumerate(table, 1):
+            line = line.strip()
+            if not line or line.startswith('#'):
+                continue
+            parts = line.split(None, 1)
+            if len(parts) != 2:
+                fail(path, line_no, 'expected `<keys> <action>`')
+            keys, action = parts
+            for key in keys:
+                if key not in KEYCODES:
+                    fail(path, line_no, f'unsupported key {key!r}')
+            if len(keys) < 2 or keys[0] != PREFIX:
+                fail(path, line_no, f'sequences are {PREFIX!r} followed by at least one key')
+            sequences.append((line_no, keys, action.strip()))
+    return sequences
+
+
+def build(path, sequences):
+    root = Node('KC_NO')
+    actions = []
+    for line_no, keys, action in sequences:
+        node = root
+        for key in keys:
+            child = next((c for c in node.children if c.keycode == KEYCODES[key]), None)
+            if child is None:
+                child = Node(KEYCODES[key])
+                node.children.append(child)
+            node = child
+        if node.action:
+            fail(path, line_no, f'duplicate sequence {keys!r}')
+        actions.append((keys, action))
+        node.action = len(actions)
+
+    # Breadth-first numbering keeps siblings next to each other in flash.
+    nodes = [root]
+    for node in nodes:
+        nodes.extend(node.children)
+    if len(nodes) > MAX_NODES or len(actions) > MAX_NODES:
+        sys.exit(f'{path}: too many sequences, the trie is limited to {MAX_NODES} nodes')
+    for index, node in enumerate(nodes):
+        node.index = index
+    return nodes, actions
+
+
+def render(source, nodes, actions):
+    out = [
+        f'// Generated by leader_seq_trie.py from {os.path.basename(source)}, do not edit.',
+        '#pragma once',
+        '',
+        f'#define LEADER_SEQ_NODE_COUNT {len(nodes)}',
+        f'#define LEADER_SEQ_MAX_DEPTH {max((len(keys) for keys, _ in actions), default=1)}',
+        '',
+        'static const leader_seq_node_t PROGMEM leader_seq_trie[] = {',
+    ]
+    for node in nodes:
+        child = node.children[0].index if node.children else 0
+        sibling = 0
+        for parent in nodes:
+            if node in parent.children:
+                position = parent.children.index(node)
+                if position + 1 < len(parent.children):
+                    sibling = parent.children[position + 1].index
+        out.append(f'    {{{node.keycode}, {child}, {sibling}, {node.action}}},')
+    out += [
+        '};',
+        '',
+        'static void leader_seq_run_action(uint8_t action) {',
+        '    switch (action) {',
+    ]
+    for index, (keys, action) in enumerate(actions, 1):
+        out.append(f'        case {index}: // {keys}')
+        if action.startswith('"') or action.startswith('SS_'):
+            out.append(f'            SEND_STRING_PACKED({action});')
+        else:
+            out.append(f'            tap_code16({action});')
+        out.append('            break;')
+    out += [
+        '    }',
+        '}',
+        '',
+    ]
+    return '\n'.join(out)
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit(__doc__.strip().splitlines()[2])
+    source, target = sys.argv[1:]
+    nodes, actions = build(source, parse(source))
+    content = render(source, nodes, actions)
+
+    if os.path.exists(target):
+        with open(target, encoding='utf-8') as current:
+            if current.read() == content:
+                return
+    with open(target, 'w', encoding='utf-8') as output:
+        output.write(content)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,13 @@
+HEARTER_USER_DIR := $(patsubst %/,%,$(dir $(lastword $(MAKEFILE_LIST))))
+
+# Leader sequences, the trie is generated from leader_seq.txt on every build.
+SRC += leader_seq.c
+ifneq ($(shell python3 $(HEARTER_USER_DIR)/leader_seq_trie.py $(HEARTER_USER_DIR)/leader_seq.txt $(HEARTER_USER_DIR)/leader_seq_trie.h && echo ok),ok)
+    $(error leader_seq_trie.py failed, leader_seq_trie.h was not updated)
+endif
+
+# Report-packing SEND_STRING for macros.
+SRC += send_string_packed.c
+
+# Time-budgeted scheduler for the periodic user jobs.
+SRC += user_tasks.c
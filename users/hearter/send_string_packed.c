@@ -0,0 +1,121 @@
+/**
+ * Copyright 2023 Hearter
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "send_string_packed.h"
+
+#include <ctype.h>
+
+// Key and weak mods currently held down by the packed sender.
+static uint8_t packed_keycode = KC_NO;
+static uint8_t packed_mods    = 0;
+
+static void packed_send_report(void) {
+    send_keyboard_report();
+#if SEND_STRING_PACKED_DELAY_MS > 0
+    wait_ms(SEND_STRING_PACKED_DELAY_MS);
+#endif
+}
+
+static void packed_release(void) {
+    if (packed_keycode == KC_NO && packed_mods == 0) {
+        return;
+    }
+    if (packed_keycode != KC_NO) {
+        del_key(packed_keycode);
+    }
+    del_weak_mods(packed_mods);
+    packed_send_report();
+    packed_keycode = KC_NO;
+    packed_mods    = 0;
+}
+
+static void packed_type_char(char ascii_code) {
+    uint8_t keycode = pgm_read_byte(&ascii_to_keycode_lut[(uint8_t)ascii_code]);
+    uint8_t mods    = 0;
+    if (PGM_LOADBIT(ascii_to_shift_lut, (uint8_t)ascii_code)) {
+        mods |= MOD_BIT(KC_LEFT_SHIFT);
+    }
+    if (PGM_LOADBIT(ascii_to_altgr_lut, (uint8_t)ascii_code)) {
+        mods |= MOD_BIT(KC_RIGHT_ALT);
+    }
+
+    if (keycode == packed_keycode || mods != packed_mods) {
+        // Repeated key or modifier change: release everything on its own report
+        // first, then switch modifiers before any key goes down.
+        if (packed_keycode != KC_NO) {
+            del_key(packed_keycode);
+            packed_keycode = KC_NO;
+        }
+        if (mods != packed_mods) {
+            del_weak_mods(packed_mods);
+            add_weak_mods(mods);
+            packed_mods = mods;
+        }
+        packed_send_report();
+    } else if (packed_keycode != KC_NO) {
+        // Released in the same report that presses the next key.
+        del_key(packed_keycode);
+    }
+
+    add_key(keycode);
+    packed_keycode = keycode;
+    packed_send_report();
+}
+
+static void packed_send(const char *string, bool progmem) {
+#define PACKED_READ(p) (progmem ? (char)pgm_read_byte(p) : *(p))
+    for (char ascii_code = PACKED_READ(string); ascii_code != '\0'; ascii_code = PACKED_READ(++string)) {
+        if (ascii_code != SS_QMK_PREFIX) {
+            if (PGM_LOADBIT(ascii_to_dead_lut, (uint8_t)ascii_code)) {
+                // Dead keys need their own tap/space dance.
+                packed_release();
+                send_char(ascii_code);
+            } else {
+                packed_type_char(ascii_code);
+            }
+            continue;
+        }
+
+        // Same escape codes as send_string_with_delay().
+        packed_release();
+        ascii_code = PACKED_READ(++string);
+        if (ascii_code == SS_TAP_CODE) {
+            tap_code((uint8_t)PACKED_READ(++string));
+        } else if (ascii_code == SS_DOWN_CODE) {
+            register_code((uint8_t)PACKED_READ(++string));
+        } else if (ascii_code == SS_UP_CODE) {
+            unregister_code((uint8_t)PACKED_READ(++string));
+        } else if (ascii_code == SS_DELAY_CODE) {
+            uint16_t ms    = 0;
+            char     digit = PACKED_READ(++string);
+            while (isdigit(digit)) {
+                ms    = ms * 10 + (digit - '0');
+                digit = PACKED_READ(++string);
+            }
+            wait_ms(ms);
+        }
+    }
+#undef PACKED_READ
+    packed_release();
+}
+
+void send_string_packed(const char *string) {
+    packed_send(string, false);
+}
+
+void send_string_packed_P(const char *string) {
+    packed_send(string, true);
+}
@@ -0,0 +1,46 @@
+/**
+ * Copyright 2023 Hearter
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "quantum.h"
+
+/**
+ * \brief SEND_STRING variant that needs about one HID report per character.
+ *
+ * Plain `SEND_STRING` sends a press and a release report for every character.
+ * This sender releases the previous key in the same report that presses the
+ * next one, and only inserts an extra report when the host needs one to keep
+ * the text intact:
+ *
+ * - the same key twice in a row, which has to be seen going up in between;
+ * - a modifier change (eg. shifted to unshifted), which gets its own report
+ *   without any key down so the host cannot apply it to the wrong key.
+ *
+ * Characters still reach the host strictly one key at a time, so typing order
+ * never depends on how the host orders keys within a report.  `SS_TAP`,
+ * `SS_DOWN`, `SS_UP` and `SS_DELAY` codes behave like in `SEND_STRING`.
+ */
+
+/** \brief Extra delay after each report, on top of the USB polling interval. */
+#ifndef SEND_STRING_PACKED_DELAY_MS
+#    define SEND_STRING_PACKED_DELAY_MS 0
+#endif // SEND_STRING_PACKED_DELAY_MS
+
+#define SEND_STRING_PACKED(string) send_string_packed_P(PSTR(string))
+
+void send_string_packed(const char *string);
+void send_string_packed_P(const char *string);
@@ -0,0 +1,148 @@
+/**
+ * Copyright 2023 Hearter
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "user_tasks.h"
+
+#ifdef __AVR__
+#    include <util/atomic.h>
+#    include "timer_avr.h"
+#endif
+
+typedef struct {
+    user_task_fn_t fn;
+    uint16_t       period_ms;
+    uint16_t       last_run;
+    uint8_t        budget_ms;
+} user_task_t;
+
+static user_task_t             tasks[USER_TASKS_MAX];
+static user_task_stats_t       stats[USER_TASKS_MAX];
+static user_tasks_loop_stats_t loop_stats;
+static uint8_t                 task_count  = 0;
+static uint8_t                 next_task   = 0;
+static uint32_t                last_loop   = 0;
+static uint16_t                loops       = 0;
+static uint16_t                loops_timer = 0;
+
+uint32_t user_tasks_timer_us(void) {
+#ifdef __AVR__
+    uint32_t ms;
+    uint8_t  raw;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        ms  = timer_read32();
+        raw = TIMER_RAW;
+        // Timer0 wrapped but its interrupt has not counted the millisecond yet.
+        if ((TIFR0 & _BV(OCF0A)) && raw < TIMER_RAW_TOP / 2) {
+            ms++;
+        }
+    }
+    return ms * 1000 + raw * (1000000UL / TIMER_RAW_FREQ);
+#else
+    return timer_read32() * 1000;
+#endif
+}
+
+static uint16_t clamp_us(uint32_t us) {
+    return us > UINT16_MAX ? UINT16_MAX : us;
+}
+
+int8_t user_task_register(user_task_fn_t fn, uint16_t period_ms, uint8_t budget_ms) {
+    if (task_count >= USER_TASKS_MAX) {
+        return -1;
+    }
+    tasks[task_count] = (user_task_t){
+        .fn        = fn,
+        .period_ms = period_ms,
+        .last_run  = timer_read(),
+        .budget_ms = budget_ms,
+    };
+    return task_count++;
+}
+
+static uint32_t user_task_run(uint8_t id) {
+    uint16_t start    = timer_read();
+    uint32_t start_us = user_tasks_timer_us();
+    tasks[id].fn();
+    uint32_t elapsed = user_tasks_timer_us() - start_us;
+
+    tasks[id].last_run = start;
+    if (elapsed > stats[id].worst_us) {
+        stats[id].worst_us = clamp_us(elapsed);
+    }
+    uint32_t budget = tasks[id].budget_ms ? tasks[id].budget_ms * 1000UL : 999;
+    if (elapsed > budget) {
+        stats[id].overruns++;
+        dprintf("user task %u overran: %lu us, budget %u ms\n", id, (unsigned long)elapsed, tasks[id].budget_ms);
+        return elapsed;
+    }
+    // Charge the declared budget, so sub-millisecond jobs never defer others.
+    return tasks[id].budget_ms * 1000UL;
+}
+
+void user_tasks_run(void) {
+    uint32_t loop_start = user_tasks_timer_us();
+    uint32_t spent      = 0;
+    bool     ran        = false;
+    uint8_t  first      = next_task;
+
+    if (last_loop != 0 && loop_start - last_loop > loop_stats.worst_loop_us) {
+        loop_stats.worst_loop_us = clamp_us(loop_start - last_loop);
+    }
+    last_loop = loop_start;
+    loops++;
+    if (timer_elapsed(loops_timer) >= 1000) {
+        loops_timer            = timer_read();
+        loop_stats.loops_per_s = loops;
+        loops                  = 0;
+    }
+
+    for (uint8_t i = 0; i < task_count; i++) {
+        uint8_t id = (first + i) % task_count;
+        if (timer_elapsed(tasks[id].last_run) < tasks[id].period_ms) {
+            continue;
+        }
+        if (ran && spent + tasks[id].budget_ms * 1000UL > USER_TASKS_SCAN_BUDGET_MS * 1000UL) {
+            // Out of budget: this job goes first on the next loop.
+            stats[id].deferrals++;
+            next_task = id;
+            break;
+        }
+        spent += user_task_run(id);
+        ran       = true;
+        next_task = (id + 1) % task_count;
+    }
+
+    uint32_t elapsed = user_tasks_timer_us() - loop_start;
+    if (elapsed > loop_stats.worst_run_us) {
+        loop_stats.worst_run_us = clamp_us(elapsed);
+    }
+}
+
+const user_task_stats_t *user_task_stats(int8_t id) {
+    return id >= 0 && id < task_count ? &stats[id] : NULL;
+}
+
+const user_tasks_loop_stats_t *user_tasks_loop_stats(void) {
+    return &loop_stats;
+}
+
+void user_tasks_stats_reset(void) {
+    memset(stats, 0, sizeof(stats));
+    loop_stats.worst_loop_us = 0;
+    loop_stats.worst_run_us  = 0;
+    // The loop that typed the report out is not one to count.
+    last_loop = 0;
+}
@@ -0,0 +1,88 @@
+/**
+ * Copyright 2023 Hearter
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "quantum.h"
+
+/**
+ * \brief Cooperative scheduler for the periodic user jobs.
+ *
+ * Jobs register a period and a per-run budget.  `user_tasks_run()` is called
+ * once per main loop from `housekeeping_task_user`; it goes round-robin over
+ * the jobs that are due and runs them while the sum of their budgets fits in
+ * `USER_TASKS_SCAN_BUDGET_MS`.  The rest are deferred to the next loop, and
+ * the first one deferred goes first then, so no job starves.  At least one
+ * due job runs per loop even when its budget alone exceeds the loop budget.
+ *
+ * Budgets are declared in milliseconds.  A budget of 0 declares a
+ * sub-millisecond job that never defers the others; every run is still timed
+ * and counted as an overrun when it takes longer than declared, or 1 ms for a
+ * budget of 0.
+ *
+ * Runs are timed in microseconds.  On AVR the clock is the QMK timer plus the
+ * Timer0 count within the current millisecond, 4 us steps at 16 MHz.  Other
+ * platforms only have the 1 ms QMK timer: their figures are in 1 ms steps, so
+ * a run is seen to overrun a budget of N ms only once it reaches N + 1 ms.
+ */
+
+/** \brief Maximum number of registered jobs. */
+#ifndef USER_TASKS_MAX
+#    define USER_TASKS_MAX 6
+#endif // USER_TASKS_MAX
+
+/** \brief Sum of job budgets allowed in a single main loop. */
+#ifndef USER_TASKS_SCAN_BUDGET_MS
+#    define USER_TASKS_SCAN_BUDGET_MS 1
+#endif // USER_TASKS_SCAN_BUDGET_MS
+
+typedef void (*user_task_fn_t)(void);
+
+/** \brief Per-job counters, since boot or the last `user_tasks_stats_reset()`. */
+typedef struct {
+    uint16_t overruns;  // Runs that took longer than the budget
+    uint16_t deferrals; // Loops the job was due but pushed to the next one
+    uint16_t worst_us;  // Longest run seen, saturates at UINT16_MAX
+} user_task_stats_t;
+
+/** \brief Main loop counters, `user_tasks_run()` being called once per loop. */
+typedef struct {
+    uint16_t loops_per_s;   // Loops in the last full second
+    uint16_t worst_loop_us; // Longest time between two loops
+    uint16_t worst_run_us;  // Longest time spent in a single `user_tasks_run()`
+} user_tasks_loop_stats_t;
+
+/**
+ * \brief Register a job to run every `period_ms` (0: every loop).
+ *
+ * Returns the job id, or -1 when `USER_TASKS_MAX` jobs are registered.
+ */
+int8_t user_task_register(user_task_fn_t fn, uint16_t period_ms, uint8_t budget_ms);
+
+/** \brief Run the due jobs that fit in this loop's budget. */
+void user_tasks_run(void);
+
+/** \brief Counters of a registered job, NULL for an unknown id. */
+const user_task_stats_t *user_task_stats(int8_t id);
+
+/** \brief Main loop counters. */
+const user_tasks_loop_stats_t *user_tasks_loop_stats(void);
+
+/** \brief Clear the overrun, deferral and worst time counters. */
+void user_tasks_stats_reset(void);
+
+/** \brief Microsecond clock used for the counters, see above for its resolution. */
+uint32_t user_tasks_timer_us(void);